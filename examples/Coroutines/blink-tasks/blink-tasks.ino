@@ -0,0 +1,35 @@
+// Requires a core built with C++20 (e.g. ESP32 Arduino 3.x or RP2040 with
+// -std=gnu++20).
+#include "DelayTask.h"
+
+// Pins where the LEDs are connected.
+#define LED1_PIN 12
+#define LED2_PIN 11
+
+DelayScheduler scheduler;
+DelayExecutor executor(scheduler);
+
+// Blinking one LED, written as straight-line code.
+DelayTask blink(uint8_t pin, unsigned long onTime, unsigned long offTime) {
+  for (;;) {
+    digitalWrite(pin, HIGH);
+    co_await Delay::for_ms(onTime);
+    digitalWrite(pin, LOW);
+    co_await Delay::for_ms(offTime);
+  }
+}
+
+// Initialization.
+void setup() {
+  pinMode(LED1_PIN, OUTPUT);
+  pinMode(LED2_PIN, OUTPUT);
+
+  executor.spawn(blink(LED1_PIN, 200, 800));
+  executor.spawn(blink(LED2_PIN, 50, 450));
+}
+
+// Event loop.
+void loop() {
+  // Resumes the tasks whose wait is over.
+  executor.run();
+}
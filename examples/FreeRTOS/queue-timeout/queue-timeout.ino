@@ -0,0 +1,65 @@
+// Requires a FreeRTOS-based core (ESP32, RP2040 with FreeRTOS).
+#include "DelayScheduler.h"
+
+// Pin where the LED is connected.
+#define LED_PIN 12
+
+Delay blinkDelay(500);
+Delay reportDelay(5000);
+DelayScheduler scheduler;
+QueueHandle_t commands;
+
+// Toggling the LED.
+void toggleLed() {
+  digitalWrite(LED_PIN, !digitalRead(LED_PIN));
+}
+
+// Printing a report.
+void report() {
+  Serial.println("Still running");
+}
+
+// Owning the timers: the task wakes up only for a deadline or a command.
+void timerTask(void*) {
+  for (;;) {
+    unsigned long left = scheduler.timeUntilNext();
+    TickType_t ticks = left == ULONG_MAX ? portMAX_DELAY
+                                         : pdMS_TO_TICKS(left) + 1;
+
+    char command;
+    if (xQueueReceive(commands, &command, ticks) == pdTRUE) {
+      if (command == 'p') {
+        blinkDelay.suspend(3000, true);
+      } else if (command == 'f') {
+        blinkDelay.setInterval(100);
+      }
+    }
+
+    scheduler.run();
+  }
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_PIN, OUTPUT);
+
+  blinkDelay.setCallback(toggleLed);
+  reportDelay.setCallback(report);
+  scheduler.add(blinkDelay);
+  scheduler.add(reportDelay);
+
+  commands = xQueueCreate(4, sizeof(char));
+  xTaskCreate(timerTask, "timers", 2048, nullptr, 1, nullptr);
+}
+
+// Event loop.
+void loop() {
+  // Forwarding the commands to the task that owns the timers.
+  if (Serial.available() > 0) {
+    char command = Serial.read();
+    xQueueSend(commands, &command, 0);
+  }
+
+  delay(10);
+}
@@ -0,0 +1,30 @@
+#include "Debouncer.h"
+
+// Pin where the button is connected, to the ground.
+#define BUTTON_PIN 2
+
+// Released at start, with the pull-up the input is HIGH.
+Debouncer<20> button(HIGH);
+unsigned long presses = 0;
+
+// Recording every change, bounces included.
+void onButtonChange() {
+  button.feed(digitalRead(BUTTON_PIN));
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(9600);
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButtonChange, CHANGE);
+}
+
+// Event loop.
+void loop() {
+  // While the button is idle this reads no clock.
+  if (button.update() == DebounceEdge::Falling) {
+    presses++;
+    Serial.print("Pressed ");
+    Serial.println(presses);
+  }
+}
@@ -0,0 +1,56 @@
+#include "Delay.h"
+#include "DelayDispatcher.h"
+
+// Deadlines are detected in the Timer1 compare interrupt every
+// millisecond, the callbacks run in loop() where Serial is safe.
+
+Delay sampleDelay(10);
+Delay reportDelay(1000);
+
+DelayDispatcher<2> dispatcher;
+
+unsigned int samples = 0;
+
+#if defined(__AVR__)
+ISR(TIMER1_COMPA_vect) {
+  dispatcher.tick();
+}
+#endif
+
+// Counting the samples.
+void takeSample() {
+  samples++;
+}
+
+// Printing the number of samples per second.
+void report() {
+  Serial.print("Samples per second: ");
+  Serial.println(samples);
+  samples = 0;
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(9600);
+
+  sampleDelay.setCallback(takeSample);
+  reportDelay.setCallback(report);
+
+  dispatcher.add(sampleDelay);
+  dispatcher.add(reportDelay);
+
+#if defined(__AVR__)
+  // Timer1 in CTC mode, 16 MHz / 64 / 250 = 1 kHz.
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+  OCR1A = 249;
+  TIMSK1 |= _BV(OCIE1A);
+  interrupts();
+#endif
+}
+
+// Event loop.
+void loop() {
+  dispatcher.dispatchPending();
+}
@@ -0,0 +1,37 @@
+#include "DelayHardwareTimer.h"
+
+// Pin where the strobe is connected.
+#define STROBE_PIN 12
+
+// The strobe runs from the timer interrupt, the status LED from loop().
+Delay strobeDelay(20);
+Delay statusDelay(500);
+
+// Pulsing the strobe, called in interrupt context.
+void fireStrobe() {
+  digitalWrite(STROBE_PIN, !digitalRead(STROBE_PIN));
+}
+
+// Initialization.
+void setup() {
+  pinMode(STROBE_PIN, OUTPUT);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  strobeDelay.setMode(DelayMode::Periodic);
+  strobeDelay.setCallback(fireStrobe);
+  DelayHardwareTimer::add(strobeDelay);
+  DelayHardwareTimer::begin();
+}
+
+// Event loop.
+void loop() {
+  // Runs the strobe only on cores without a hardware backend.
+  DelayHardwareTimer::poll();
+
+  if (statusDelay.isDone()) {
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+  }
+
+  // Blocking work no longer delays the strobe.
+  delay(100);
+}
@@ -0,0 +1,46 @@
+#include "Delay.h"
+#include "DelayPolicy.h"
+
+// Pins where the LEDs are connected.
+#define LED_1_PIN 12
+#define LED_2_PIN 11
+
+// LED 1 blinks slower and slower, as a reconnect loop would retry,
+// and starts over when the cap is reached. LED 2 speeds up step by step.
+DelayBackoffPolicy led1Backoff(50, 2000, 2, 10);
+DelayLinearPolicy led2Ramp(-50, 100, 1000);
+
+Delay led1Delay(50);
+Delay led2Delay(1000);
+
+// Initialization.
+void setup() {
+  Serial.begin(9600);
+
+  pinMode(LED_1_PIN, OUTPUT);
+  pinMode(LED_2_PIN, OUTPUT);
+
+  led1Delay.setPolicy(&led1Backoff);
+  led2Delay.setPolicy(&led2Ramp);
+  led2Delay.setMode(DelayMode::Periodic);
+}
+
+// Event loop.
+void loop() {
+  if (led1Delay.isOver()) {
+    bool isLow = digitalRead(LED_1_PIN) == LOW;
+    digitalWrite(LED_1_PIN, isLow ? HIGH : LOW);
+
+    Serial.print("LED 1, next interval (ms): ");
+    Serial.println(led1Delay.getInterval());
+
+    if (led1Delay.getInterval() > 1800) {
+      led1Delay.setInterval(led1Backoff.reset());
+    }
+  }
+
+  if (led2Delay.isOver()) {
+    bool isLow = digitalRead(LED_2_PIN) == LOW;
+    digitalWrite(LED_2_PIN, isLow ? HIGH : LOW);
+  }
+}
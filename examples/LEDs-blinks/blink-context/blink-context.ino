@@ -0,0 +1,34 @@
+#include "Delay.h"
+
+// An LED with its own delay. One handler serves all of them.
+struct Led {
+  uint8_t pin;
+  Delay delay;
+};
+
+// Pins where the LEDs are connected and their delays.
+Led led1 = {12, Delay(500)};
+Led led2 = {11, Delay(750)};
+
+// Changing the status of the LED passed as the context.
+void toggleLed(void* context) {
+  Led* led = static_cast<Led*>(context);
+  bool isLow = digitalRead(led->pin) == LOW;
+  digitalWrite(led->pin, isLow ? HIGH : LOW);
+}
+
+// Initialization.
+void setup() {
+  pinMode(led1.pin, OUTPUT);
+  pinMode(led2.pin, OUTPUT);
+
+  led1.delay.setCallback(toggleLed, &led1);
+  led2.delay.setCallback(toggleLed, &led2);
+}
+
+// Event loop.
+void loop() {
+  unsigned long now = millis();
+  led1.delay.execCallback(now);
+  led2.delay.execCallback(now);
+}
@@ -0,0 +1,46 @@
+#include "Delay.h"
+#include "DelayScheduler.h"
+
+// Pins where the LEDs are connected.
+#define LED_1_PIN 12
+#define LED_2_PIN 11
+
+// Delay for changing the state of the LEDs.
+Delay led1Delay(500);
+Delay led2Delay(750);
+
+// Scheduler that knows the earliest deadline.
+DelayScheduler scheduler;
+
+// Initialization.
+void setup() {
+  pinMode(LED_1_PIN, OUTPUT);
+  pinMode(LED_2_PIN, OUTPUT);
+
+  led1Delay.setCallback(toggleLed1);
+  led2Delay.setCallback(toggleLed2);
+
+  scheduler.add(led1Delay);
+  scheduler.add(led2Delay);
+}
+
+// Event loop.
+void loop() {
+  scheduler.run();
+
+  // Instead of busy-polling, sleep until the next LED has to change
+  // its state. The time spent in deep sleep is added to millis().
+  scheduler.sleepUntilNextDeadline(DelaySleepMode::PowerDown);
+}
+
+// Changing the status of the LED 1.
+void toggleLed1() {
+  bool isLow = digitalRead(LED_1_PIN) == LOW;
+  digitalWrite(LED_1_PIN, isLow ? HIGH : LOW);
+}
+
+// Changing the status of the LED 2.
+void toggleLed2() {
+  bool isLow = digitalRead(LED_2_PIN) == LOW;
+  digitalWrite(LED_2_PIN, isLow ? HIGH : LOW);
+}
@@ -0,0 +1,43 @@
+#include "DelayTable.h"
+
+// Pins where the LEDs are connected.
+#define LED1_PIN 12
+#define LED2_PIN 11
+
+// Toggling the first LED.
+void toggleLed1() {
+  digitalWrite(LED1_PIN, !digitalRead(LED1_PIN));
+}
+
+// Toggling the second LED.
+void toggleLed2() {
+  digitalWrite(LED2_PIN, !digitalRead(LED2_PIN));
+}
+
+// Printing the uptime.
+void report() {
+  Serial.println(millis());
+}
+
+// The intervals and callbacks are compiled into the code, only the three
+// timestamps and the active bits are in RAM.
+DelayTable<
+  DelayEntry<500, toggleLed1>,
+  DelayEntry<750, toggleLed2, DelayMode::Periodic>,
+  DelayEntry<5000, report, DelayMode::Periodic>
+> timers;
+
+// Initialization.
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED1_PIN, OUTPUT);
+  pinMode(LED2_PIN, OUTPUT);
+
+  timers.start(millis());
+}
+
+// Event loop.
+void loop() {
+  // One compare and one direct call per timer, unrolled.
+  timers.run();
+}
@@ -0,0 +1,21 @@
+#include "BasicDelay.h"
+
+// Pin where the STEP input of the stepper driver is connected.
+#define STEP_PIN 9
+
+// Toggling the pin every 100 us gives a 200 us step period
+// without blocking the program with delayMicroseconds().
+MicroDelay stepDelay(100);
+
+// Initialization.
+void setup() {
+  pinMode(STEP_PIN, OUTPUT);
+}
+
+// Event loop.
+void loop() {
+  if (stepDelay.isOver()) {
+    bool isLow = digitalRead(STEP_PIN) == LOW;
+    digitalWrite(STEP_PIN, isLow ? HIGH : LOW);
+  }
+}
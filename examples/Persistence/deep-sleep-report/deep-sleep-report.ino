@@ -0,0 +1,56 @@
+#include "Delay.h"
+
+// A one-hour report that keeps its phase across deep sleep cycles.
+// The state of the timer is saved to RTC memory (ESP32) or EEPROM
+// before sleeping and restored after the wake-up.
+
+#define REPORT_INTERVAL 3600000UL
+#define SLEEP_TIME 60000UL
+
+Delay reportDelay(REPORT_INTERVAL);
+
+#if defined(ESP32)
+RTC_DATA_ATTR DelaySnapshot reportSnapshot;
+#else
+#include <EEPROM.h>
+DelaySnapshot reportSnapshot;
+#endif
+
+// Sending the report.
+void report() {
+  Serial.print("Report #");
+  Serial.println(reportDelay.getCount());
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+
+#if !defined(ESP32)
+  EEPROM.get(0, reportSnapshot);
+#endif
+
+  // The first boot has no valid snapshot, so the timer starts over.
+  if (reportDelay.restore(reportSnapshot, SLEEP_TIME)) {
+    Serial.print("Next report in (ms): ");
+    Serial.println(reportDelay.remainingTime());
+  }
+}
+
+// Main loop.
+void loop() {
+  if (reportDelay.isOver()) {
+    report();
+  }
+
+  // The timer is saved right before the sleep.
+  reportSnapshot = reportDelay.serialize();
+
+#if defined(ESP32)
+  esp_deep_sleep(SLEEP_TIME * 1000ULL);
+#else
+  // Without deep sleep support, a reset stands in for the wake-up.
+  EEPROM.put(0, reportSnapshot);
+  delay(SLEEP_TIME);
+#endif
+}
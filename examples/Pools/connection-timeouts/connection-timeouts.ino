@@ -0,0 +1,59 @@
+#include "DelayPool.h"
+
+// Idle timeouts for many clients. Each client gets a pool timer that is
+// restarted on every message and closes the client when it expires.
+
+#define CLIENTS 256
+#define IDLE_TIMEOUT 5000
+
+DelayPool<CLIENTS> timeouts;
+DelayPool<CLIENTS>::Handle handles[CLIENTS];
+uint16_t clientIds[CLIENTS];
+
+// Closing an idle client.
+void closeClient(void* context) {
+  uint16_t client = *static_cast<uint16_t*>(context);
+  timeouts.remove(handles[client]);
+  handles[client] = DelayPool<CLIENTS>::None;
+
+  Serial.print("Closed idle client ");
+  Serial.println(client);
+}
+
+// Registering a new client.
+void onConnect(uint16_t client) {
+  handles[client] = timeouts.add(IDLE_TIMEOUT);
+  if (handles[client] == DelayPool<CLIENTS>::None) {
+    // The pool is full, the client gets no timeout.
+    return;
+  }
+
+  clientIds[client] = client;
+  timeouts.setCallback(handles[client], closeClient, &clientIds[client]);
+}
+
+// Restarting the timeout of an active client. The pool ignores the
+// handle of a closed client.
+void onMessage(uint16_t client) {
+  timeouts.resetTime(handles[client], millis());
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+
+  for (uint16_t client = 0; client < CLIENTS; client++) {
+    onConnect(client);
+  }
+}
+
+// Main loop.
+void loop() {
+  // Simulating traffic on the even clients only.
+  static uint16_t next = 0;
+  onMessage(next);
+  next = (next + 2) % CLIENTS;
+
+  // One scan of the deadlines finds all idle clients.
+  timeouts.run();
+}
@@ -0,0 +1,26 @@
+#include "RateLimiter.h"
+
+// Bursts of up to 5 uploads, then at most one every 2 seconds.
+RateLimiter uploadLimiter(5, 2000);
+unsigned long dropped = 0;
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+}
+
+// Event loop.
+void loop() {
+  // A new sample arrives on each byte from the serial port.
+  if (Serial.available() > 0) {
+    int sample = Serial.read();
+
+    // The bucket is refilled from the elapsed time, no timer is polled.
+    if (uploadLimiter.tryAcquire()) {
+      Serial.print("Upload ");
+      Serial.println(sample);
+    } else {
+      dropped++;
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#include "DelayTimeoutQueue.h"
+
+// The number of sessions and their idle timeout.
+#define MAX_SESSIONS 64
+#define IDLE_TIMEOUT 30000
+
+// 256 slots of 128 ms make a turn of 32.8 s, just above the timeout.
+DelayTimeoutQueue<256, 128> idleTimeouts;
+DelayTimeout sessionTimeouts[MAX_SESSIONS];
+uint8_t sessionIds[MAX_SESSIONS];
+
+// Closing an idle session.
+void closeSession(void* context) {
+  uint8_t session = *static_cast<uint8_t*>(context);
+  Serial.print("Session ");
+  Serial.print(session);
+  Serial.println(" timed out");
+}
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+
+  for (uint8_t i = 0; i < MAX_SESSIONS; i++) {
+    sessionIds[i] = i;
+    sessionTimeouts[i].setCallback(closeSession, &sessionIds[i]);
+    idleTimeouts.arm(sessionTimeouts[i], IDLE_TIMEOUT);
+  }
+}
+
+// Event loop.
+void loop() {
+  // Each received packet re-arms the timeout of its session in O(1).
+  if (Serial.available() > 0) {
+    uint8_t session = Serial.read() % MAX_SESSIONS;
+    idleTimeouts.arm(sessionTimeouts[session], IDLE_TIMEOUT);
+  }
+
+  // Only the slots that are due are walked.
+  idleTimeouts.run();
+}
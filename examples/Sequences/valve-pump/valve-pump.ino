@@ -0,0 +1,50 @@
+#include "DelaySequence.h"
+
+// Pins where the valve and the pump relays are connected.
+#define VALVE_PIN 12
+#define PUMP_PIN 11
+
+// Opening the valve.
+void openValve() {
+  digitalWrite(VALVE_PIN, HIGH);
+}
+
+// Starting the pump.
+void pumpOn() {
+  digitalWrite(PUMP_PIN, HIGH);
+}
+
+// Stopping the pump.
+void pumpOff() {
+  digitalWrite(PUMP_PIN, LOW);
+}
+
+// Closing the valve.
+void closeValve() {
+  digitalWrite(VALVE_PIN, LOW);
+}
+
+// Valve open -> wait -> pump on -> wait -> pump off -> wait -> valve
+// closed -> pause, then the cycle repeats. The table is kept in flash.
+const DelayStep cycle[] PROGMEM = {
+  {1000, openValve},
+  {5000, pumpOn},
+  {1000, pumpOff},
+  {10000, closeValve},
+};
+
+DelaySequence cycleSequence(cycle, true);
+
+// Initialization.
+void setup() {
+  pinMode(VALVE_PIN, OUTPUT);
+  pinMode(PUMP_PIN, OUTPUT);
+
+  cycleSequence.start();
+}
+
+// Event loop.
+void loop() {
+  // One timer drives the whole cycle.
+  cycleSequence.update();
+}
@@ -0,0 +1,75 @@
+#include "Delay.h"
+
+// Measures the CPU cycles of the hot path on AVR with Timer1 running at
+// the CPU clock (no prescaler). Each measurement is repeated RUNS times
+// and the average is printed, including the loop overhead.
+
+#define RUNS 1000
+
+Delay pollDelay(60000);  // never due during the benchmark
+
+volatile unsigned long timestamp = 0;
+volatile unsigned long now = 0;
+volatile unsigned long sink = 0;
+
+// The original rollover handling of getDelta(): a branch and an
+// off-by-one range (ULONG_MAX - timestamp + now).
+unsigned long branchDelta(unsigned long m, unsigned long ts) {
+  return m < ts ? ULONG_MAX - ts + m : m - ts;
+}
+
+// The modular arithmetic used now.
+unsigned long modularDelta(unsigned long m, unsigned long ts) {
+  return m - ts;
+}
+
+// Returns the number of Timer1 ticks (CPU cycles) of the measured block.
+#define MEASURE(block)               \
+  ({                                 \
+    noInterrupts();                  \
+    TCNT1 = 0;                       \
+    for (int i = 0; i < RUNS; i++) { \
+      block;                         \
+    }                                \
+    uint16_t ticks = TCNT1;          \
+    interrupts();                    \
+    ticks;                           \
+  })
+
+void setup() {
+  Serial.begin(9600);
+
+#if defined(__AVR__)
+  // Timer1 in normal mode without prescaler, overflows after 65536 cycles,
+  // so RUNS * cycles per call must stay below that.
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+
+  unsigned long start = millis();
+  now = start;
+  timestamp = start - 10;
+
+  uint16_t empty = MEASURE(sink = now);
+  uint16_t branch = MEASURE(sink = branchDelta(now, timestamp));
+  uint16_t modular = MEASURE(sink = modularDelta(now, timestamp));
+  uint16_t poll = MEASURE(sink = pollDelay.isOver(start));
+  uint16_t pollMillis = MEASURE(sink = pollDelay.isOver());
+
+  Serial.println("Cycles per call (x1000 runs, overhead included):");
+  Serial.print("Empty loop:          ");
+  Serial.println(empty / (float)RUNS);
+  Serial.print("Branch getDelta:     ");
+  Serial.println(branch / (float)RUNS);
+  Serial.print("Modular getDelta:    ");
+  Serial.println(modular / (float)RUNS);
+  Serial.print("isOver(now), not due: ");
+  Serial.println(poll / (float)RUNS);
+  Serial.print("isOver(), not due:   ");
+  Serial.println(pollMillis / (float)RUNS);
+#else
+  Serial.println("The cycle-count benchmark requires an AVR board.");
+#endif
+}
+
+void loop() {
+}
@@ -0,0 +1,58 @@
+#include "Delay.h"
+#include "DelayProfiler.h"
+
+// Build with DELAY_ENABLE_PROFILER set to 1 (see src/DelayConfig.h).
+// Send 'p' over Serial to receive a binary snapshot of the loop load.
+
+Delay sensorDelay(10);    // Object with a quick callback
+Delay displayDelay(250);  // Object with a slow callback
+
+DelayScheduler scheduler;
+
+#if DELAY_ENABLE_PROFILER
+DelayProfiler profiler;
+#endif
+
+// A quick callback.
+void readSensor() {
+  analogRead(A0);
+}
+
+// A slow callback, as if it was drawing on a display.
+void updateDisplay() {
+  delayMicroseconds(4000);
+}
+
+void setup() {
+  // Initialize serial port.
+  Serial.begin(115200);
+
+  sensorDelay.setCallback(readSensor);
+  displayDelay.setCallback(updateDisplay);
+  scheduler.add(sensorDelay);
+  scheduler.add(displayDelay);
+
+#if DELAY_ENABLE_PROFILER
+  sensorDelay.setTag(1);
+  displayDelay.setTag(2);
+  scheduler.setProfiler(&profiler);
+
+  // Callbacks of 2 ms or longer are recorded with their tag.
+  profiler.setThreshold(2000);
+#endif
+}
+
+void loop() {
+#if DELAY_ENABLE_PROFILER
+  profiler.beginLoop();
+#endif
+
+  scheduler.run();
+
+#if DELAY_ENABLE_PROFILER
+  if (Serial.read() == 'p') {
+    profiler.writeSnapshot(Serial);
+    profiler.reset();
+  }
+#endif
+}
@@ -0,0 +1,48 @@
+#include "Delay.h"
+#include "DelayScheduler.h"
+
+// Pin of the PWM output driven by the control loop.
+#define OUTPUT_PIN 9
+
+// Control loop every millisecond, telemetry every second.
+Delay controlDelay(1);
+Delay telemetryDelay(1000);
+
+// Scheduler that serves the control loop first.
+DelayScheduler scheduler;
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+  pinMode(OUTPUT_PIN, OUTPUT);
+
+  controlDelay.setMode(DelayMode::Periodic);
+  controlDelay.setPriority(DelayPriority::High);
+  controlDelay.setCallback(control);
+
+  telemetryDelay.setPriority(DelayPriority::Low);
+  telemetryDelay.setCallback(sendTelemetry);
+
+  scheduler.add(controlDelay);
+  scheduler.add(telemetryDelay);
+
+  // At most 500 µs of callbacks per pass, the control loop is never
+  // deferred.
+  scheduler.setBudget(500);
+}
+
+// Event loop.
+void loop() {
+  scheduler.run();
+}
+
+// Reading the input and updating the output.
+void control() {
+  analogWrite(OUTPUT_PIN, analogRead(A0) / 4);
+}
+
+// Printing the number of passes that deferred the telemetry.
+void sendTelemetry() {
+  Serial.print("Overruns: ");
+  Serial.println(scheduler.getOverruns());
+}
@@ -0,0 +1,53 @@
+#include "Delay.h"
+
+// Build with DELAY_ENABLE_STATS set to 1 (see src/DelayConfig.h), so the
+// timers record their own lateness and callback times.
+
+Delay workDelay(20);      // Object with a busy callback
+Delay reportDelay(5000);  // Object to print the statistics
+
+// A callback of varying length.
+void doWork() {
+  delayMicroseconds(200 + random(2000));
+}
+
+void setup() {
+  // Initialize serial port.
+  Serial.begin(9600);
+
+  workDelay.setCallback(doWork);
+}
+
+void loop() {
+  workDelay.execCallback();
+
+#if DELAY_ENABLE_STATS
+  if (reportDelay.isOver()) {
+    const DelayStats& stats = workDelay.getStats();
+    Serial.print("Triggers: ");
+    Serial.print(stats.triggers);
+    Serial.print(", lateness min/mean/max: ");
+    Serial.print(stats.minLateness);
+    Serial.print("/");
+    Serial.print(stats.getMeanLateness());
+    Serial.print("/");
+    Serial.print(stats.maxLateness);
+    Serial.print("ms, longest callback: ");
+    Serial.print(stats.maxCallbackTime);
+    Serial.println("us");
+
+    Serial.print("Callback histogram:");
+    for (uint8_t i = 0; i < DELAY_STATS_BUCKETS; i++) {
+      Serial.print(" ");
+      Serial.print(stats.callbackHistogram[i]);
+    }
+    Serial.println();
+
+    workDelay.resetStats();
+  }
+#else
+  if (reportDelay.isOver()) {
+    Serial.println("DELAY_ENABLE_STATS is not set.");
+  }
+#endif
+}
@@ -0,0 +1,36 @@
+#include "Delay.h"
+#include "DelayScheduler.h"
+#include "DelayTimeBase.h"
+
+// Delay for printing the uptime.
+Delay reportDelay(60000);
+
+// Scheduler that also keeps the 64-bit time base current.
+DelayScheduler scheduler;
+
+// Initialization.
+void setup() {
+  Serial.begin(115200);
+
+  reportDelay.setCallback(printUptime);
+  scheduler.add(reportDelay);
+}
+
+// Event loop.
+void loop() {
+  scheduler.run();
+}
+
+// Printing the uptime, correct past the 49.7 days of millis().
+void printUptime() {
+  uint64_t now = DelayTimeBase::millis64();
+  uint32_t minutes = now / 60000;
+
+  Serial.print("Uptime: ");
+  Serial.print(minutes / 1440);
+  Serial.print(" d ");
+  Serial.print(minutes / 60 % 24);
+  Serial.print(" h ");
+  Serial.print(minutes % 60);
+  Serial.println(" min");
+}
@@ -0,0 +1,45 @@
+#include "Arduino.h"
+
+// The state of the mock clock.
+static unsigned long hostMillis = 0;
+static unsigned long hostMicros = 0;
+static unsigned long hostMicrosFraction = 0;
+
+unsigned long millis() {
+    return (uint32_t)hostMillis;
+}
+
+unsigned long micros() {
+    return (uint32_t)hostMicros;
+}
+
+long random(long howbig) {
+    return howbig == 0 ? 0 : rand() % howbig;
+}
+
+void delay(unsigned long ms) {
+    advanceMillis(ms);
+}
+
+void setMillis(unsigned long ms) {
+    hostMillis = ms;
+    hostMicros = ms * 1000;
+    hostMicrosFraction = 0;
+}
+
+void advanceMillis(unsigned long ms) {
+    hostMillis += ms;
+    hostMicros += ms * 1000;
+}
+
+void setMicros(unsigned long us) {
+    hostMicros = us;
+    hostMicrosFraction = 0;
+}
+
+void advanceMicros(unsigned long us) {
+    hostMicros += us;
+    hostMicrosFraction += us;
+    hostMillis += hostMicrosFraction / 1000;
+    hostMicrosFraction %= 1000;
+}
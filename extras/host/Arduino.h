@@ -0,0 +1,134 @@
+/**
+ * @brief Provides the subset of the Arduino core used by the library, for
+ * the native host build.
+ *
+ * The clock is a mock controlled by the tests, so every timing scenario,
+ * including the millis() rollover, is deterministic.
+ */
+#ifndef _DELAY_HOST_ARDUINO_H
+#define _DELAY_HOST_ARDUINO_H
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define PROGMEM
+#define memcpy_P memcpy
+
+/**
+ * @brief The byte output of the Arduino core, reduced to the raw writes.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+
+    /**
+     * @brief Writes a single byte.
+     *
+     * @param[in] value The byte to write.
+     *
+     * @return The number of bytes written.
+     */
+    virtual size_t write(uint8_t value) = 0;
+
+    /**
+     * @brief Writes a buffer byte by byte.
+     *
+     * @param[in] buffer The bytes to write.
+     * @param[in] size The number of bytes.
+     *
+     * @return The number of bytes written.
+     */
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t written = 0;
+        while (size-- > 0) {
+            written += this->write(*buffer++);
+        }
+
+        return written;
+    }
+};
+
+/**
+ * @brief Returns the mock time in milliseconds.
+ *
+ * The time wraps at 32 bits like on the real cores, even where
+ * `unsigned long` is 64-bit.
+ */
+unsigned long millis();
+
+/**
+ * @brief Returns the mock time in microseconds, wrapped at 32 bits.
+ */
+unsigned long micros();
+
+/**
+ * @brief Returns a pseudo-random number from the C library.
+ *
+ * @param[in] howbig The upper bound, exclusive.
+ *
+ * @return A number from 0 to `howbig - 1`, zero if `howbig` is zero.
+ */
+long random(long howbig);
+
+/**
+ * @brief Advances the mock clock instead of blocking.
+ *
+ * @param[in] ms The time to advance in milliseconds.
+ */
+void delay(unsigned long ms);
+
+/**
+ * @brief Does nothing, there are no interrupts on the host.
+ */
+inline void noInterrupts() {}
+
+/**
+ * @brief Does nothing, there are no interrupts on the host.
+ */
+inline void interrupts() {}
+
+/**
+ * @brief Does nothing, there is no scheduler on the host.
+ */
+inline void yield() {}
+
+/**
+ * @brief Sets the mock time in milliseconds.
+ *
+ * The microsecond time is set to the same moment, truncated to the range
+ * of `unsigned long`.
+ *
+ * @param[in] ms The new time in milliseconds.
+ */
+void setMillis(unsigned long ms);
+
+/**
+ * @brief Advances the mock time by the given number of milliseconds.
+ *
+ * @param[in] ms The time to advance in milliseconds.
+ */
+void advanceMillis(unsigned long ms);
+
+/**
+ * @brief Sets the mock time in microseconds, leaving millis() as is.
+ *
+ * @param[in] us The new time in microseconds.
+ */
+void setMicros(unsigned long us);
+
+/**
+ * @brief Advances the mock time by the given number of microseconds.
+ *
+ * millis() advances by every full millisecond passed.
+ *
+ * @param[in] us The time to advance in microseconds.
+ */
+void advanceMicros(unsigned long us);
+
+#endif  // _DELAY_HOST_ARDUINO_H
@@ -0,0 +1,71 @@
+/**
+ * @brief Measures the cost of polling Delay objects on the host.
+ *
+ * For each timer count, all timers are polled against a moving mock clock,
+ * once directly with isOver() and once through a DelayScheduler. The
+ * figures are nanoseconds per timer and per pass, and are only comparable
+ * between runs on the same machine.
+ */
+#include <stdio.h>
+
+#include <chrono>
+#include <vector>
+
+#include "Delay.h"
+#include "DelayScheduler.h"
+
+static unsigned long fired = 0;
+
+static void onFire() {
+    fired++;
+}
+
+/**
+ * @brief Returns the average time of one pass in nanoseconds.
+ */
+template <typename Pass>
+static double measure(unsigned long passes, Pass pass) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < passes; i++) {
+        pass(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::nano> elapsed = end - start;
+    return elapsed.count() / passes;
+}
+
+int main() {
+    const size_t sizes[] = {1, 10, 100, 1000, 10000};
+
+    printf("%8s %16s %16s\n", "timers", "isOver ns/timer", "run ns/timer");
+    for (size_t size : sizes) {
+        std::vector<Delay> delays(size);
+        for (size_t i = 0; i < size; i++) {
+            delays[i].setInterval(50 + i % 1000);
+            delays[i].setCallback(onFire);
+        }
+
+        unsigned long passes = 10000000UL / size;
+        double polling = measure(passes, [&delays](unsigned long now) {
+            for (Delay& delay : delays) {
+                delay.execCallback(now);
+            }
+        });
+
+        DelayScheduler scheduler;
+        for (Delay& delay : delays) {
+            delay.resetTime(0);
+            scheduler.add(delay);
+        }
+
+        double running = measure(passes, [&scheduler](unsigned long now) {
+            scheduler.run(now);
+        });
+
+        printf("%8zu %16.2f %16.2f\n", size, polling / size, running / size);
+    }
+
+    printf("fired %lu\n", fired);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "test.h"
+
+// The registered test cases, in reverse order of registration.
+static TestCase* testCases = nullptr;
+
+// The number of failed checks of the running test case.
+static int testFailures = 0;
+
+TestCase::TestCase(const char* name, void (*function)())
+    : name(name), function(function), next(testCases) {
+    testCases = this;
+}
+
+void testFail(const char* file, int line, const char* expression) {
+    printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+    testFailures++;
+}
+
+int main() {
+    // Restore the order of registration.
+    TestCase* ordered = nullptr;
+    while (testCases != nullptr) {
+        TestCase* next = testCases->next;
+        testCases->next = ordered;
+        ordered = testCases;
+        testCases = next;
+    }
+
+    int total = 0;
+    int failed = 0;
+    for (TestCase* test = ordered; test != nullptr; test = test->next) {
+        setMillis(0);
+        testFailures = 0;
+        test->function();
+
+        total++;
+        if (testFailures != 0) {
+            failed++;
+            printf("FAIL %s\n", test->name);
+        }
+    }
+
+    printf("%d of %d tests passed\n", total - failed, total);
+    return failed == 0 ? 0 : 1;
+}
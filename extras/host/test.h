@@ -0,0 +1,57 @@
+/**
+ * @brief Provides a minimal test runner for the native host build.
+ *
+ */
+#ifndef _DELAY_HOST_TEST_H
+#define _DELAY_HOST_TEST_H
+
+#include <stdio.h>
+
+#include "Arduino.h"
+
+/**
+ * @brief A registered test case.
+ */
+struct TestCase {
+    const char* name;
+    void (*function)();
+    TestCase* next;
+
+    TestCase(const char* name, void (*function)());
+};
+
+/**
+ * @brief Reports a failed check of the running test case.
+ *
+ * @param[in] file The source file of the check.
+ * @param[in] line The line of the check.
+ * @param[in] expression The text of the failed expression.
+ */
+void testFail(const char* file, int line, const char* expression);
+
+/**
+ * @brief Defines and registers a test case.
+ *
+ * The mock clock is reset to zero before each test case.
+ */
+#define TEST(name)                                       \
+    static void test_##name();                           \
+    static TestCase testCase_##name(#name, test_##name); \
+    static void test_##name()
+
+/**
+ * @brief Checks that the expression is true.
+ */
+#define CHECK(expression)                                  \
+    do {                                                   \
+        if (!(expression)) {                               \
+            testFail(__FILE__, __LINE__, #expression);     \
+        }                                                  \
+    } while (0)
+
+/**
+ * @brief Checks that the two values are equal.
+ */
+#define CHECK_EQUAL(expected, actual) CHECK((expected) == (actual))
+
+#endif  // _DELAY_HOST_TEST_H
@@ -0,0 +1,199 @@
+#include "AtomicDelay.h"
+#include "DelayDispatcher.h"
+#include "test.h"
+
+#if defined(DELAY_HAS_ATOMIC)
+#include <thread>
+#endif
+
+static int dispatched = 0;
+
+static void countDispatch() {
+    dispatched++;
+}
+
+TEST(dispatcherDefersCallbacks) {
+    dispatched = 0;
+    Delay delay(10);
+    delay.setCallback(countDispatch);
+
+    DelayDispatcher<1, 2> dispatcher;
+    CHECK(dispatcher.add(delay));
+
+    CHECK_EQUAL(1, dispatcher.tick(10));
+    CHECK_EQUAL(0, dispatched);
+    CHECK_EQUAL(1, dispatcher.getPending());
+
+    CHECK_EQUAL(1, dispatcher.dispatchPending());
+    CHECK_EQUAL(1, dispatched);
+    CHECK_EQUAL(0, dispatcher.getPending());
+}
+
+TEST(dispatcherCountsDropped) {
+    Delay delay(0);
+    DelayDispatcher<1, 2> dispatcher;
+    dispatcher.add(delay);
+
+    dispatcher.tick(0);
+    dispatcher.tick(0);
+    dispatcher.tick(0);
+    CHECK_EQUAL(2, dispatcher.getPending());
+    CHECK_EQUAL(1, dispatcher.getDropped());
+}
+
+#if defined(DELAY_HAS_ATOMIC)
+TEST(atomicDelayTriggersOncePerExpiry) {
+    AtomicDelay delay(100);
+
+    CHECK(!delay.isOver(99));
+    CHECK(delay.isOver(100));
+    CHECK(!delay.isOver(100));
+    CHECK_EQUAL(1U, delay.getCount());
+}
+
+TEST(atomicDelaySuspend) {
+    AtomicDelay delay(100);
+
+    delay.suspend(100, false, 0);
+    CHECK(delay.isSuspended());
+    CHECK(!delay.isOver(100));
+    CHECK(delay.isEnabled());
+    CHECK(!delay.isOver(199));
+    CHECK(delay.isOver(200));
+}
+
+// The races below are run many times on two threads, released together
+// so that their atomic operations interleave.
+static const int raceRounds = 500;
+
+/**
+ * @brief Runs both functions on their own threads, started together.
+ */
+template <typename First, typename Second>
+static void race(First first, Second second) {
+    std::atomic<int> ready(0);
+    std::thread thread([&] {
+        ready++;
+        while (ready.load() < 2) {
+            std::this_thread::yield();
+        }
+        second();
+    });
+
+    ready++;
+    while (ready.load() < 2) {
+        std::this_thread::yield();
+    }
+    first();
+    thread.join();
+}
+
+TEST(atomicDelayUsesWordAtomics) {
+    CHECK(std::atomic<uint32_t>().is_lock_free());
+}
+
+TEST(atomicDelayZeroIntervalClaimedOnce) {
+    for (int round = 0; round < raceRounds; round++) {
+        AtomicDelay delay(0);
+        std::atomic<int> wins(0);
+        auto poll = [&] {
+            for (int i = 0; i < 4; i++) {
+                if (delay.isOver(5)) {
+                    wins++;
+                }
+            }
+        };
+
+        race(poll, poll);
+        CHECK_EQUAL(1, wins.load());
+        CHECK_EQUAL(1U, delay.getCount());
+    }
+}
+
+TEST(atomicDelayExpiryClaimedOnce) {
+    for (int round = 0; round < raceRounds; round++) {
+        AtomicDelay delay(10);
+        std::atomic<int> wins(0);
+        auto poll = [&] {
+            for (int i = 0; i < 4; i++) {
+                if (delay.isOver(15)) {
+                    wins++;
+                }
+            }
+        };
+
+        race(poll, poll);
+        CHECK_EQUAL(1, wins.load());
+        CHECK_EQUAL(1U, delay.getCount());
+    }
+}
+
+TEST(atomicDelayNoExpiryAfterDisable) {
+    for (int round = 0; round < raceRounds; round++) {
+        AtomicDelay delay(1);
+        std::atomic<bool> isDisabled(false);
+        std::atomic<int> late(0);
+        race(
+            [&] {
+                for (uint32_t now = 1; now < 200; now++) {
+                    bool wasDisabled = isDisabled.load();
+                    if (delay.isOver(now) && wasDisabled) {
+                        late++;
+                    }
+                }
+            },
+            [&] {
+                delay.disable();
+                isDisabled.store(true);
+            });
+
+        CHECK_EQUAL(0, late.load());
+        CHECK(!delay.isEnabled());
+    }
+}
+
+TEST(atomicDelayNoExpiryAfterSuspend) {
+    for (int round = 0; round < raceRounds; round++) {
+        AtomicDelay delay(1);
+        std::atomic<bool> isSuspended(false);
+        std::atomic<int> late(0);
+        race(
+            [&] {
+                for (uint32_t now = 1; now < 200; now++) {
+                    bool wasSuspended = isSuspended.load();
+                    if (delay.isOver(now) && wasSuspended) {
+                        late++;
+                    }
+                }
+            },
+            [&] {
+                delay.suspend(1000, false, 1);
+                isSuspended.store(true);
+            });
+
+        CHECK_EQUAL(0, late.load());
+        CHECK(delay.isSuspended());
+    }
+}
+
+TEST(atomicDelaySuspendAgainNotEndedEarly) {
+    for (int round = 0; round < raceRounds; round++) {
+        AtomicDelay delay(100);
+        delay.suspend(10, false, 0);
+        race(
+            [&] {
+                for (int i = 0; i < 50; i++) {
+                    delay.isOver(10);
+                }
+            },
+            [&] { delay.suspend(1000, false, 10); });
+
+        // The second suspend lasts until 1010, whichever thread ran first.
+        for (int i = 0; i < 4; i++) {
+            delay.isOver(10);
+        }
+
+        CHECK(delay.isSuspended());
+    }
+}
+#endif
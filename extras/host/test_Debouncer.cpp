@@ -0,0 +1,61 @@
+#include <limits.h>
+
+#include "Debouncer.h"
+#include "test.h"
+
+TEST(debouncerFitsInOneWord) {
+    CHECK_EQUAL(4u, sizeof(Debouncer<20>));
+}
+
+TEST(debouncerReportsStableEdge) {
+    Debouncer<20> button(true);
+    CHECK(button.read());
+    CHECK(!button.isPending());
+
+    // Bounces restart the debounce time.
+    button.feed(false, 100);
+    button.feed(true, 103);
+    button.feed(false, 105);
+    CHECK(button.isPending());
+    CHECK(button.update(124) == DebounceEdge::None);
+    CHECK(button.update(125) == DebounceEdge::Falling);
+    CHECK(button.update(200) == DebounceEdge::None);
+    CHECK(!button.isPending());
+
+    button.feed(true, 300);
+    CHECK(button.update(320) == DebounceEdge::Rising);
+}
+
+TEST(debouncerIgnoresShortGlitch) {
+    Debouncer<20> button(false);
+    button.feed(true, 100);
+    button.feed(false, 110);
+    CHECK(!button.isPending());
+    CHECK(button.update(200) == DebounceEdge::None);
+}
+
+TEST(debouncerIgnoresRepeatedLevel) {
+    Debouncer<20> button(false);
+    button.feed(true, 100);
+    button.feed(true, 115);
+    CHECK(button.update(120) == DebounceEdge::Rising);
+}
+
+TEST(debouncerReadsClockOnlyWhenPending) {
+    Debouncer<10> button(false);
+    setMillis(50);
+    button.feed(true);
+    setMillis(60);
+    CHECK(button.read());
+}
+
+TEST(debouncerSurvivesTimestampWrap) {
+    Debouncer<20> button(false);
+    unsigned long wrap = 1UL << 30;
+    button.feed(true, wrap - 5);
+    CHECK(button.update(wrap + 14) == DebounceEdge::None);
+    CHECK(button.update(wrap + 15) == DebounceEdge::Rising);
+
+    button.feed(false, ULONG_MAX - 5);
+    CHECK(button.update(14) == DebounceEdge::Falling);
+}
@@ -0,0 +1,324 @@
+#include "Delay.h"
+#include "DelayFunction.h"
+#include "test.h"
+
+TEST(isOverTriggersAfterInterval) {
+    Delay delay(100);
+
+    setMillis(99);
+    CHECK(!delay.isOver());
+
+    setMillis(100);
+    CHECK(delay.isOver());
+    CHECK(!delay.isOver());
+    CHECK_EQUAL(1UL, delay.getCount());
+}
+
+TEST(isOverRestartsFromPollTime) {
+    Delay delay(100);
+
+    setMillis(130);
+    CHECK(delay.isOver());
+
+    setMillis(229);
+    CHECK(!delay.isOver());
+
+    setMillis(230);
+    CHECK(delay.isOver());
+}
+
+TEST(isDoneMatchesIsOver) {
+    Delay delay(50);
+
+    setMillis(50);
+    CHECK(delay.isDone());
+
+    setMillis(99);
+    CHECK(!delay.isDone());
+
+    setMillis(100);
+    CHECK(delay.isDone());
+}
+
+TEST(zeroIntervalIsAlwaysReady) {
+    Delay delay(0);
+
+    CHECK(delay.isOver());
+    CHECK(delay.isOver());
+}
+
+TEST(counterParity) {
+    Delay delay(10);
+    CHECK(delay.isNever());
+    CHECK(!delay.isEven());
+    CHECK(!delay.isOdd());
+
+    setMillis(10);
+    delay.isOver();
+    CHECK(delay.isOdd());
+
+    setMillis(20);
+    delay.isOver();
+    CHECK(delay.isEven());
+
+    delay.resetCount();
+    CHECK(delay.isNever());
+}
+
+TEST(disableAndEnable) {
+    Delay delay(100);
+    delay.disable();
+
+    setMillis(500);
+    CHECK(!delay.isOver());
+
+    delay.enable();
+    setMillis(599);
+    CHECK(!delay.isOver());
+
+    setMillis(600);
+    CHECK(delay.isOver());
+}
+
+TEST(inactiveConstruction) {
+    Delay delay(10, false);
+
+    setMillis(100);
+    CHECK(!delay.isOver());
+}
+
+TEST(suspendRestartsInterval) {
+    Delay delay(100);
+
+    setMillis(40);
+    delay.suspend(200);
+
+    // The poll that ends the suspend never triggers.
+    setMillis(240);
+    CHECK(!delay.isOver());
+
+    setMillis(339);
+    CHECK(!delay.isOver());
+
+    setMillis(340);
+    CHECK(delay.isOver());
+}
+
+TEST(suspendContinuesInterval) {
+    Delay delay(100);
+
+    setMillis(40);
+    delay.suspend(200, true);
+
+    setMillis(240);
+    CHECK(!delay.isOver());
+
+    setMillis(299);
+    CHECK(!delay.isOver());
+
+    setMillis(300);
+    CHECK(delay.isOver());
+}
+
+TEST(enableCancelsSuspend) {
+    Delay delay(100);
+    delay.suspend(1000);
+
+    setMillis(10);
+    delay.enable();
+
+    setMillis(110);
+    CHECK(delay.isOver());
+}
+
+TEST(rolloverIsHandled) {
+    setMillis(ULONG_MAX - 20);
+    Delay delay(50);
+
+    setMillis(28);
+    CHECK_EQUAL(49UL, delay.getDelta());
+    CHECK(!delay.isOver());
+
+    setMillis(29);
+    CHECK(delay.isOver());
+}
+
+TEST(nowOverloadsDoNotReadClock) {
+    Delay delay(100);
+
+    // The clock is not advanced, only the passed time is used.
+    CHECK(!delay.isOver(99));
+    CHECK(delay.isOver(100));
+    CHECK_EQUAL(0UL, delay.getDelta(100));
+    CHECK(delay.isDone(200));
+
+    delay.resetTime(1000);
+    CHECK_EQUAL(5UL, delay.getDelta(1005));
+}
+
+TEST(periodicModeKeepsPhase) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic);
+
+    // Polled late, the next deadline is still 200.
+    setMillis(130);
+    CHECK(delay.isOver());
+
+    setMillis(199);
+    CHECK(!delay.isOver());
+
+    setMillis(200);
+    CHECK(delay.isOver());
+    CHECK_EQUAL(0UL, delay.getMissed());
+}
+
+TEST(periodicModeSkip) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic, DelayCatchUp::Skip);
+
+    setMillis(350);
+    CHECK(delay.isOver());
+    CHECK(!delay.isOver());
+    CHECK_EQUAL(2UL, delay.getMissed());
+    CHECK_EQUAL(1UL, delay.getCount());
+
+    setMillis(400);
+    CHECK(delay.isOver());
+}
+
+TEST(periodicModeBurst) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic, DelayCatchUp::Burst);
+
+    setMillis(350);
+    CHECK(delay.isOver());
+    CHECK(delay.isOver());
+    CHECK(delay.isOver());
+    CHECK(!delay.isOver());
+    CHECK_EQUAL(3UL, delay.getCount());
+}
+
+TEST(periodicModeCoalesce) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic, DelayCatchUp::Coalesce);
+
+    setMillis(350);
+    CHECK(delay.isOver());
+    CHECK(!delay.isOver());
+    CHECK_EQUAL(2UL, delay.getMissed());
+    CHECK_EQUAL(3UL, delay.getCount());
+}
+
+static int plainCalls = 0;
+
+static void plainCallback() {
+    plainCalls++;
+}
+
+static void contextCallback(void* context) {
+    (*static_cast<int*>(context))++;
+}
+
+TEST(execCallbackPlain) {
+    plainCalls = 0;
+    Delay delay(10);
+    delay.setCallback(plainCallback);
+    CHECK(delay.hasCallback());
+
+    setMillis(9);
+    CHECK(!delay.execCallback());
+
+    setMillis(10);
+    CHECK(delay.execCallback());
+    CHECK_EQUAL(1, plainCalls);
+}
+
+TEST(execCallbackWithContext) {
+    int calls = 0;
+    Delay delay(10);
+    delay.setCallback(contextCallback, &calls);
+    CHECK(delay.getCallback() == nullptr);
+    CHECK(delay.getCallbackContext() == &calls);
+
+    CHECK(delay.execCallback(10));
+    CHECK(delay.execCallback(20));
+    CHECK_EQUAL(2, calls);
+}
+
+TEST(execCallbackWithFunctor) {
+    int calls = 0;
+    auto functor = [&calls]() { calls++; };
+    Delay delay(10);
+    delay.setCallback(functor);
+
+    CHECK(delay.execCallback(10));
+    CHECK_EQUAL(1, calls);
+}
+
+TEST(delayFunctionCopiesCapture) {
+    int total = 0;
+    int* target = &total;
+    int step = 3;
+    DelayFunction<> function = [target, step]() { *target += step; };
+
+    Delay delay(10);
+    delay.setCallback(function);
+    delay.execCallback(10);
+    delay.execCallback(20);
+    CHECK_EQUAL(6, total);
+}
+
+TEST(oneShotFiresOnce) {
+    Delay timeout(100);
+    timeout.setMode(DelayMode::OneShot);
+
+    CHECK(!timeout.isOver(99));
+    CHECK(timeout.isOver(130));
+    CHECK(!timeout.isActive);
+    CHECK_EQUAL(30UL, timeout.getDelta(130) - timeout.getInterval());
+    CHECK(!timeout.isOver(1000));
+    CHECK_EQUAL(1UL, timeout.getCount());
+
+    timeout.restart(1000);
+    CHECK(!timeout.isOver(1099));
+    CHECK(timeout.isOver(1100));
+}
+
+TEST(oneShotCancel) {
+    Delay timeout(100);
+    timeout.setMode(DelayMode::OneShot);
+
+    timeout.cancel();
+    CHECK(!timeout.isOver(500));
+    CHECK_EQUAL(ULONG_MAX, timeout.remainingTime(500));
+}
+
+TEST(remainingTime) {
+    Delay delay(100);
+
+    CHECK_EQUAL(60UL, delay.remainingTime(40));
+    CHECK_EQUAL(0UL, delay.remainingTime(150));
+
+    // 200 of suspend, then the 60 left in the interval.
+    delay.suspend(200, true, 40);
+    CHECK_EQUAL(260UL, delay.remainingTime(40));
+    CHECK_EQUAL(60UL, delay.remainingTime(240));
+}
+
+TEST(timeUntilUpdateStopsAtSuspendEnd) {
+    Delay delay(100);
+    CHECK_EQUAL(60UL, delay.timeUntilUpdate(40));
+
+    // Suspended at 40 for 200 ms, 40 ms into the interval.
+    delay.suspend(200, true, 40);
+    CHECK_EQUAL(260UL, delay.remainingTime(40));
+    CHECK_EQUAL(200UL, delay.timeUntilUpdate(40));
+
+    // Blocking for the returned times meets the deadline exactly.
+    CHECK(!delay.isOver(240));
+    CHECK_EQUAL(60UL, delay.timeUntilUpdate(240));
+    CHECK(delay.isOver(300));
+
+    delay.disable();
+    CHECK_EQUAL(ULONG_MAX, delay.timeUntilUpdate(300));
+}
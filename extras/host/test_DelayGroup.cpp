@@ -0,0 +1,93 @@
+#include "DelayGroup.h"
+#include "DelayScheduler.h"
+#include "test.h"
+
+TEST(shiftWithinElapsedTime) {
+    Delay delay(100);
+
+    delay.shift(30, 50);
+    CHECK(delay.isActive);
+    CHECK(!delay.isOver(129));
+    CHECK(delay.isOver(130));
+}
+
+TEST(shiftBeyondElapsedTime) {
+    Delay delay(100);
+
+    delay.shift(250, 50);
+    CHECK(!delay.isActive);
+    CHECK(!delay.isOver(250));
+    CHECK(delay.isActive);
+    CHECK(!delay.isOver(349));
+    CHECK(delay.isOver(350));
+}
+
+TEST(shiftExtendsSuspend) {
+    Delay delay(100);
+    delay.suspend(100, false, 0);
+
+    delay.shift(50, 10);
+    CHECK(!delay.isOver(149));
+    CHECK(!delay.isActive);
+    CHECK(!delay.isOver(150));
+    CHECK(delay.isOver(250));
+}
+
+TEST(shiftKeepsSchedulerOrder) {
+    Delay delay(100);
+    DelayScheduler scheduler;
+    scheduler.add(delay);
+
+    // The scheduler wakes up at the end of the suspend first.
+    delay.shift(500, 0);
+    CHECK_EQUAL(500UL, scheduler.timeUntilNext(0));
+    CHECK_EQUAL(0U, scheduler.run(500));
+    CHECK_EQUAL(100UL, scheduler.timeUntilNext(500));
+}
+
+TEST(groupSuspendsWithOneTimestamp) {
+    Delay first(100);
+    Delay second(300);
+    DelayGroup<2> group;
+    CHECK(group.add(first));
+    CHECK(group.add(second));
+    CHECK(!group.add(first));
+
+    group.suspend(1000, true, 50);
+    CHECK(!first.isActive);
+    CHECK(!second.isActive);
+
+    CHECK(!first.isOver(1050));
+    CHECK(!second.isOver(1050));
+    CHECK(first.isOver(1100));
+    CHECK(second.isOver(1300));
+}
+
+TEST(groupSetIntervalAndEnable) {
+    Delay first(100);
+    Delay second(300);
+    DelayGroup<2> group;
+    group.add(first);
+    group.add(second);
+
+    group.disable();
+    CHECK(!first.isOver(1000));
+
+    group.setInterval(50, 1000);
+    group.enable(1000);
+    CHECK(first.isOver(1050));
+    CHECK(second.isOver(1050));
+}
+
+TEST(groupRemove) {
+    Delay first;
+    Delay second;
+    DelayGroup<2> group;
+    group.add(first);
+    group.add(second);
+
+    CHECK(group.remove(first));
+    CHECK(!group.remove(first));
+    CHECK_EQUAL(1, group.getSize());
+    CHECK(&group[0] == &second);
+}
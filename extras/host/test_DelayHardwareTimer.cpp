@@ -0,0 +1,107 @@
+#include "DelayHardwareTimer.h"
+#include "test.h"
+
+static unsigned int timerFired = 0;
+
+static void onTimer() {
+    timerFired++;
+}
+
+TEST(hardwareTimerFallsBackToPoll) {
+    timerFired = 0;
+    Delay delay(10);
+    delay.setCallback(onTimer);
+
+    CHECK(DelayHardwareTimer::add(delay));
+    CHECK(!DelayHardwareTimer::add(delay));
+    CHECK_EQUAL(1, DelayHardwareTimer::getSize());
+    CHECK(!DelayHardwareTimer::begin());
+
+    setMillis(9);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(0u, timerFired);
+
+    setMillis(10);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(1u, timerFired);
+
+    setMillis(15);
+    DelayHardwareTimer::poll();
+    setMillis(20);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(2u, timerFired);
+
+    DelayHardwareTimer::end();
+    CHECK(DelayHardwareTimer::remove(delay));
+    CHECK(!DelayHardwareTimer::remove(delay));
+}
+
+TEST(hardwareTimerWakesForEarliest) {
+    timerFired = 0;
+    Delay slow(100);
+    Delay fast(30);
+    slow.setCallback(onTimer);
+    fast.setCallback(onTimer);
+
+    DelayHardwareTimer::add(slow);
+    DelayHardwareTimer::add(fast);
+    DelayHardwareTimer::begin();
+
+    // The wake-up is at 30 ms, a poll before it does nothing.
+    setMicros(29999);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(0u, timerFired);
+
+    setMillis(30);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(1u, timerFired);
+
+    // A change from the main code needs update().
+    slow.disable();
+    fast.disable();
+    DelayHardwareTimer::update();
+    setMillis(200);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(1u, timerFired);
+
+    DelayHardwareTimer::end();
+    DelayHardwareTimer::remove(slow);
+    DelayHardwareTimer::remove(fast);
+    CHECK_EQUAL(0, DelayHardwareTimer::getSize());
+}
+
+TEST(hardwareTimerHasFixedCapacity) {
+    Delay delays[DELAY_HW_TIMER_SLOTS + 1];
+    for (uint8_t i = 0; i < DELAY_HW_TIMER_SLOTS; i++) {
+        CHECK(DelayHardwareTimer::add(delays[i]));
+    }
+
+    CHECK(!DelayHardwareTimer::add(delays[DELAY_HW_TIMER_SLOTS]));
+    for (uint8_t i = 0; i < DELAY_HW_TIMER_SLOTS; i++) {
+        CHECK(DelayHardwareTimer::remove(delays[i]));
+    }
+}
+
+TEST(hardwareTimerForgetsDestroyedDelay) {
+    timerFired = 0;
+    Delay kept(50);
+    kept.setCallback(onTimer);
+    DelayHardwareTimer::add(kept);
+    {
+        Delay destroyed(10);
+        destroyed.setCallback(onTimer);
+        CHECK(DelayHardwareTimer::add(destroyed));
+        CHECK_EQUAL(2, DelayHardwareTimer::getSize());
+    }
+
+    CHECK_EQUAL(1, DelayHardwareTimer::getSize());
+    DelayHardwareTimer::begin();
+
+    // Only the remaining object is polled.
+    setMillis(50);
+    DelayHardwareTimer::poll();
+    CHECK_EQUAL(1u, timerFired);
+
+    DelayHardwareTimer::end();
+    CHECK(DelayHardwareTimer::remove(kept));
+}
@@ -0,0 +1,95 @@
+#include "DelayPolicy.h"
+#include "test.h"
+
+TEST(backoffDoublesUpToCap) {
+    DelayBackoffPolicy backoff(100, 500);
+    Delay delay(100);
+    delay.setPolicy(&backoff);
+
+    CHECK(delay.isOver(100));
+    CHECK_EQUAL(200UL, delay.getInterval());
+    CHECK(delay.isOver(300));
+    CHECK_EQUAL(400UL, delay.getInterval());
+    CHECK(delay.isOver(700));
+    CHECK_EQUAL(500UL, delay.getInterval());
+    CHECK(!delay.isOver(1199));
+    CHECK(delay.isOver(1200));
+    CHECK_EQUAL(500UL, delay.getInterval());
+
+    CHECK_EQUAL(100UL, backoff.reset());
+}
+
+TEST(backoffJitterStaysBelowBase) {
+    DelayBackoffPolicy backoff(1000, 8000, 2, 50);
+
+    for (int i = 0; i < 20; i++) {
+        unsigned long interval = backoff.nextInterval(0, 0);
+        CHECK(interval <= 8000);
+    }
+
+    unsigned long interval = backoff.nextInterval(0, 0);
+    CHECK(interval >= 4000);
+}
+
+TEST(backoffJitterOnShortIntervals) {
+    DelayBackoffPolicy backoff(25, 50, 2, 100);
+    bool jittered = false;
+
+    for (int i = 0; i < 50; i++) {
+        backoff.reset();
+        unsigned long interval = backoff.nextInterval(0, 0);
+        CHECK(interval <= 50);
+        jittered = jittered || interval < 50;
+    }
+
+    CHECK(jittered);
+}
+
+TEST(policyKeepsPeriodicPhase) {
+    DelayLinearPolicy ramp(50, 0, 1000);
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic);
+    delay.setPolicy(&ramp);
+
+    // Polled late, the next period still starts at the deadline.
+    CHECK(delay.isOver(130));
+    CHECK_EQUAL(150UL, delay.getInterval());
+    CHECK(!delay.isOver(249));
+    CHECK(delay.isOver(250));
+}
+
+TEST(linearRampDown) {
+    DelayLinearPolicy ramp(-40, 50, 1000);
+
+    CHECK_EQUAL(60UL, ramp.nextInterval(100, 0));
+    CHECK_EQUAL(50UL, ramp.nextInterval(60, 0));
+    CHECK_EQUAL(1000UL, DelayLinearPolicy(40, 0, 1000).nextInterval(990, 0));
+}
+
+TEST(loadPolicyBacksOffUnderLoad) {
+    DelayLoadPolicy load(100, 1000, 10);
+
+    CHECK_EQUAL(400UL, load.nextInterval(200, 11));
+    CHECK_EQUAL(1000UL, load.nextInterval(800, 50));
+    CHECK_EQUAL(175UL, load.nextInterval(200, 0));
+    CHECK_EQUAL(100UL, load.nextInterval(105, 10));
+}
+
+TEST(linearStaysWithinLimits) {
+    // A step larger than the maximum must not wrap the limit check.
+    DelayLinearPolicy up(2000, 0, 1000);
+    CHECK_EQUAL(1000UL, up.nextInterval(0, 0));
+    CHECK_EQUAL(1000UL, up.nextInterval(1000, 0));
+
+    DelayLinearPolicy top(LONG_MAX, 10, ULONG_MAX - 5);
+    CHECK_EQUAL(ULONG_MAX - 5, top.nextInterval(ULONG_MAX - 100, 0));
+
+    // Neither may a minimum close to the top of the range.
+    DelayLinearPolicy down(-100, ULONG_MAX - 50, ULONG_MAX);
+    CHECK_EQUAL(ULONG_MAX - 50, down.nextInterval(ULONG_MAX, 0));
+    CHECK_EQUAL(ULONG_MAX - 50, down.nextInterval(ULONG_MAX - 50, 0));
+
+    DelayLinearPolicy exact(-40, 60, 1000);
+    CHECK_EQUAL(60UL, exact.nextInterval(100, 0));
+    CHECK_EQUAL(60UL, exact.nextInterval(60, 0));
+}
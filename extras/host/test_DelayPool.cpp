@@ -0,0 +1,115 @@
+#include "DelayPool.h"
+#include "test.h"
+
+TEST(poolGivesOutHandlesInOrder) {
+    DelayPool<3> pool;
+
+    CHECK_EQUAL(0, pool.add(10, 0));
+    CHECK_EQUAL(1, pool.add(10, 0));
+    CHECK_EQUAL(2, pool.add(10, 0));
+    CHECK(pool.isFull());
+    CHECK(pool.add(10, 0) == DelayPool<3>::None);
+
+    pool.remove(1);
+    CHECK_EQUAL(2, pool.getSize());
+    CHECK_EQUAL(1, pool.add(20, 0));
+}
+
+TEST(poolReportsOnlyExpiredActiveTimers) {
+    DelayPool<40> pool;
+    DelayPool<40>::Handle out[40];
+
+    for (uint16_t i = 0; i < 40; i++) {
+        pool.add(100 + i, 0);
+    }
+    pool.disable(35);
+
+    CHECK_EQUAL(0, pool.pollExpired(99, out, 40));
+
+    CHECK_EQUAL(36, pool.pollExpired(136, out, 40));
+    CHECK_EQUAL(0, out[0]);
+    CHECK_EQUAL(34, out[34]);
+    CHECK_EQUAL(36, out[35]);
+
+    // The reported timers are restarted.
+    CHECK_EQUAL(0, pool.pollExpired(136, out, 40));
+    CHECK_EQUAL(3, pool.pollExpired(139, out, 40));
+}
+
+TEST(poolKeepsTimersThatDoNotFitOut) {
+    DelayPool<8> pool;
+    DelayPool<8>::Handle out[4];
+
+    for (uint16_t i = 0; i < 8; i++) {
+        pool.add(10, 0);
+    }
+
+    CHECK_EQUAL(4, pool.pollExpired(10, out, 4));
+    CHECK_EQUAL(4, pool.pollExpired(10, out, 4));
+    CHECK_EQUAL(4, out[0]);
+    CHECK_EQUAL(0, pool.pollExpired(10, out, 4));
+}
+
+TEST(poolHandlesRollover) {
+    DelayPool<1> pool;
+    DelayPool<1>::Handle out[1];
+    pool.add(100, ULONG_MAX - 49);
+
+    CHECK_EQUAL(0, pool.pollExpired(49, out, 1));
+    CHECK_EQUAL(1, pool.pollExpired(50, out, 1));
+}
+
+static void countPool(void* context) {
+    (*static_cast<int*>(context))++;
+}
+
+TEST(poolRunCallsCallbacksOnce) {
+    int calls = 0;
+    DelayPool<2> pool;
+    DelayPool<2>::Handle first = pool.add(0, 0);
+    DelayPool<2>::Handle second = pool.add(50, 0);
+    pool.setCallback(first, countPool, &calls);
+    pool.setCallback(second, countPool, &calls);
+
+    CHECK_EQUAL(1, pool.run(0));
+    CHECK_EQUAL(1, calls);
+
+    CHECK_EQUAL(2, pool.run(50));
+    CHECK_EQUAL(3, calls);
+}
+
+TEST(poolIgnoresInvalidHandles) {
+    int calls = 0;
+    DelayPool<2> pool;
+    DelayPool<2>::Handle first = pool.add(10, 0);
+    DelayPool<2>::Handle second = pool.add(10, 0);
+    DelayPool<2>::Handle full = pool.add(10, 0);
+    CHECK(full == DelayPool<2>::None);
+
+    // None or out of range, nothing is written.
+    CHECK(!pool.isValid(full));
+    pool.setCallback(full, countPool, &calls);
+    pool.enable(full, 0);
+    pool.disable(full);
+    pool.setInterval(2, 10, 0);
+    CHECK(!pool.remove(full));
+    CHECK(!pool.isActive(full));
+    CHECK_EQUAL(0UL, pool.getInterval(full));
+    CHECK_EQUAL(2, pool.getSize());
+
+    // A double remove frees the handle once.
+    CHECK(pool.remove(first));
+    CHECK(!pool.remove(first));
+    CHECK(!pool.isValid(first));
+    CHECK_EQUAL(1, pool.getSize());
+
+    pool.enable(first, 0);
+    CHECK(!pool.isActive(first));
+
+    DelayPool<2>::Handle again = pool.add(20, 0);
+    CHECK(again == first);
+    CHECK(pool.add(20, 0) == DelayPool<2>::None);
+    CHECK(pool.remove(second));
+    CHECK(pool.remove(again));
+    CHECK_EQUAL(0, pool.getSize());
+}
@@ -0,0 +1,94 @@
+#include "DelayProfiler.h"
+#include "test.h"
+
+#if DELAY_ENABLE_PROFILER
+class BufferPrint : public Print {
+public:
+    uint8_t data[128];
+    size_t size = 0;
+
+    using Print::write;
+
+    size_t write(uint8_t value) override {
+        this->data[this->size++] = value;
+        return 1;
+    }
+};
+
+static void fastCallback() {
+    advanceMicros(10);
+}
+
+static void slowCallback() {
+    advanceMicros(3000);
+}
+
+TEST(profilerSplitsLoopTime) {
+    Delay fast(1);
+    Delay slow(5);
+    fast.setTag(1);
+    slow.setTag(2);
+    fast.setCallback(fastCallback);
+    slow.setCallback(slowCallback);
+
+    DelayScheduler scheduler;
+    DelayProfiler profiler;
+    scheduler.add(fast);
+    scheduler.add(slow);
+    scheduler.setProfiler(&profiler);
+
+    profiler.beginLoop();
+    for (int i = 0; i < 5; i++) {
+        advanceMicros(1000);
+        scheduler.run();
+        profiler.beginLoop();
+    }
+
+    CHECK_EQUAL(5UL, profiler.getLoops());
+    CHECK_EQUAL(3050UL, profiler.getCallbackTime());
+    CHECK_EQUAL(0UL, profiler.getPollTime());
+    CHECK_EQUAL(4010UL, profiler.getMaxLoopTime());
+
+    CHECK_EQUAL(1, profiler.getSlowCount());
+    CHECK_EQUAL(2, profiler.getSlow(0).tag);
+    CHECK_EQUAL(3000UL, profiler.getSlow(0).time);
+}
+
+TEST(profilerRingKeepsNewest) {
+    DelayProfiler profiler;
+    profiler.setThreshold(0);
+    for (uint16_t tag = 0; tag < DELAY_PROFILER_SLOTS + 2; tag++) {
+        profiler.addCallback(tag, 1);
+    }
+
+    CHECK_EQUAL(DELAY_PROFILER_SLOTS, profiler.getSlowCount());
+    CHECK_EQUAL(2, profiler.getSlow(0).tag);
+    CHECK_EQUAL(DELAY_PROFILER_SLOTS + 1,
+                profiler.getSlow(DELAY_PROFILER_SLOTS - 1).tag);
+}
+
+TEST(profilerSnapshot) {
+    DelayProfiler profiler;
+    profiler.addCallback(0x0102, 5000);
+    profiler.addIdle(7);
+
+    BufferPrint out;
+    size_t written = profiler.writeSnapshot(out);
+    CHECK_EQUAL(4U + 24U + 1U + 10U, written);
+    CHECK_EQUAL(out.size, written);
+    CHECK_EQUAL('D', out.data[0]);
+    CHECK_EQUAL('P', out.data[1]);
+    CHECK_EQUAL(DelayProfiler::SnapshotVersion, out.data[2]);
+
+    // The idle time is the sixth counter.
+    CHECK_EQUAL(7, out.data[4 + 5 * 4]);
+    CHECK_EQUAL(1, out.data[28]);
+    CHECK_EQUAL(0x02, out.data[29]);
+    CHECK_EQUAL(0x01, out.data[30]);
+    CHECK_EQUAL(0x88, out.data[31]);
+    CHECK_EQUAL(0x13, out.data[32]);
+
+    profiler.reset();
+    CHECK_EQUAL(0, profiler.getSlowCount());
+}
+#endif
@@ -0,0 +1,255 @@
+#include "DelayScheduler.h"
+#include "test.h"
+
+static int order[8];
+static int orderSize = 0;
+
+static void record(void* context) {
+    order[orderSize++] = *static_cast<int*>(context);
+}
+
+TEST(schedulerRunsOnlyDueTimers) {
+    int ids[] = {1, 2, 3};
+    Delay first(300);
+    Delay second(100);
+    Delay third(200);
+    first.setCallback(record, &ids[0]);
+    second.setCallback(record, &ids[1]);
+    third.setCallback(record, &ids[2]);
+
+    DelayScheduler scheduler;
+    scheduler.add(first);
+    scheduler.add(second);
+    scheduler.add(third);
+    CHECK_EQUAL(3U, scheduler.getSize());
+
+    orderSize = 0;
+    CHECK_EQUAL(0U, scheduler.run(99));
+    CHECK_EQUAL(1UL, scheduler.timeUntilNext(99));
+
+    CHECK_EQUAL(3U, scheduler.run(300));
+    CHECK_EQUAL(3, orderSize);
+    CHECK_EQUAL(2, order[0]);
+    CHECK_EQUAL(3, order[1]);
+    CHECK_EQUAL(1, order[2]);
+}
+
+TEST(schedulerFollowsReconfiguration) {
+    Delay fast(100);
+    Delay slow(1000);
+
+    DelayScheduler scheduler;
+    scheduler.add(fast);
+    scheduler.add(slow);
+
+    fast.disable();
+    CHECK_EQUAL(1000UL, scheduler.timeUntilNext(0));
+
+    setMillis(500);
+    fast.enable();
+    CHECK_EQUAL(100UL, scheduler.timeUntilNext(500));
+
+    slow.suspend(50);
+    CHECK_EQUAL(50UL, scheduler.timeUntilNext(500));
+}
+
+TEST(schedulerEndsSuspend) {
+    Delay delay(100);
+    DelayScheduler scheduler;
+    scheduler.add(delay);
+
+    delay.suspend(50);
+    CHECK_EQUAL(0U, scheduler.run(50));
+    CHECK(delay.isActive);
+    CHECK_EQUAL(1U, scheduler.run(150));
+}
+
+TEST(schedulerLimitsZeroInterval) {
+    Delay delay(0);
+    DelayScheduler scheduler;
+    scheduler.add(delay);
+
+    CHECK_EQUAL(1U, scheduler.run(0));
+}
+
+TEST(schedulerForgetsDestroyedTimer) {
+    DelayScheduler scheduler;
+    {
+        Delay delay(10);
+        scheduler.add(delay);
+        CHECK_EQUAL(1U, scheduler.getSize());
+    }
+
+    CHECK(scheduler.isEmpty());
+    CHECK_EQUAL(ULONG_MAX, scheduler.timeUntilNext(0));
+}
+
+TEST(schedulerCopyIsNotRegistered) {
+    DelayScheduler scheduler;
+    Delay delay(10);
+    scheduler.add(delay);
+
+    Delay copy = delay;
+    copy.resetTime(5);
+    CHECK_EQUAL(1U, scheduler.getSize());
+    CHECK(scheduler.remove(delay));
+    CHECK(!scheduler.remove(copy));
+}
+
+TEST(schedulerWakeupWithoutSlack) {
+    Delay first(100);
+    Delay second(300);
+    DelayScheduler scheduler;
+    scheduler.add(first);
+    scheduler.add(second);
+
+    CHECK_EQUAL(100UL, scheduler.timeUntilWakeup(0));
+}
+
+TEST(schedulerMergesWakeupsWithinSlack) {
+    Delay sensor(9800);
+    Delay telemetry(10000);
+    Delay strict(20000);
+    sensor.setSlack(500);
+    telemetry.setSlack(500);
+
+    DelayScheduler scheduler;
+    scheduler.add(sensor);
+    scheduler.add(telemetry);
+    scheduler.add(strict);
+
+    CHECK_EQUAL(9800UL, scheduler.timeUntilNext(0));
+    CHECK_EQUAL(10300UL, scheduler.timeUntilWakeup(0));
+
+    // A single wakeup serves both tolerant timers.
+    CHECK_EQUAL(10300UL, scheduler.sleepUntilNextDeadline());
+    CHECK_EQUAL(2U, scheduler.run());
+}
+
+static void slowRecord(void* context) {
+    record(context);
+    advanceMicros(600);
+}
+
+TEST(schedulerDefersLowPriorityOverBudget) {
+    int ids[] = {1, 2, 3};
+    Delay control(100);
+    Delay telemetry(100);
+    Delay log(100);
+    control.setCallback(slowRecord, &ids[0]);
+    telemetry.setCallback(slowRecord, &ids[1]);
+    log.setCallback(slowRecord, &ids[2]);
+    control.setPriority(DelayPriority::High);
+    log.setPriority(DelayPriority::Low);
+    CHECK(control.getPriority() == DelayPriority::High);
+
+    DelayScheduler scheduler;
+    scheduler.add(log);
+    scheduler.add(telemetry);
+    scheduler.add(control);
+    scheduler.setBudget(1000);
+
+    // The high class runs first, the first normal fits into the budget.
+    orderSize = 0;
+    CHECK_EQUAL(2U, scheduler.run(100));
+    CHECK_EQUAL(2, orderSize);
+    CHECK_EQUAL(1, order[0]);
+    CHECK_EQUAL(2, order[1]);
+    CHECK_EQUAL(1UL, scheduler.getOverruns());
+    CHECK_EQUAL(0UL, scheduler.timeUntilNext(100));
+
+    // The deferred object runs in the next pass.
+    CHECK_EQUAL(1U, scheduler.run(101));
+    CHECK_EQUAL(3, order[2]);
+    CHECK_EQUAL(99UL, scheduler.timeUntilNext(101));
+
+    scheduler.resetOverruns();
+    CHECK_EQUAL(0UL, scheduler.getOverruns());
+}
+
+TEST(schedulerNeverDefersHighPriority) {
+    int ids[] = {1, 2};
+    Delay first(100);
+    Delay second(100);
+    first.setCallback(slowRecord, &ids[0]);
+    second.setCallback(slowRecord, &ids[1]);
+    first.setPriority(DelayPriority::High);
+    second.setPriority(DelayPriority::High);
+
+    DelayScheduler scheduler;
+    scheduler.add(first);
+    scheduler.add(second);
+    scheduler.setBudget(100);
+
+    orderSize = 0;
+    CHECK_EQUAL(2U, scheduler.run(100));
+    CHECK_EQUAL(0UL, scheduler.getOverruns());
+}
+
+TEST(schedulerMovesObjectToNewPriority) {
+    Delay delay(100);
+    DelayScheduler scheduler;
+    scheduler.add(delay);
+
+    delay.setPriority(DelayPriority::Low);
+    CHECK_EQUAL(1U, scheduler.getSize());
+    CHECK_EQUAL(100UL, scheduler.timeUntilNext(0));
+    CHECK_EQUAL(1U, scheduler.run(100));
+    CHECK(scheduler.remove(delay));
+}
+
+TEST(schedulerStopsAtDisabledTimers) {
+    static Delay disabled[2000];
+    Delay oneShot(10);
+    Delay active(100);
+    oneShot.setMode(DelayMode::OneShot);
+
+    DelayScheduler scheduler;
+    for (Delay& delay : disabled) {
+        delay.disable();
+        scheduler.add(delay);
+    }
+
+    scheduler.add(oneShot);
+    scheduler.add(active);
+
+    CHECK_EQUAL(1U, scheduler.run(10));
+    CHECK(!oneShot.isActive);
+
+    // The fired one-shot and the disabled objects stay behind the active
+    // one and are never checked.
+    for (unsigned long now = 11; now < 100; now++) {
+        CHECK_EQUAL(0U, scheduler.run(now));
+    }
+
+    CHECK_EQUAL(1U, scheduler.run(100));
+    CHECK_EQUAL(100UL, scheduler.timeUntilNext(100));
+
+    disabled[1999].setInterval(50);
+    disabled[1999].enable(100);
+    CHECK_EQUAL(50UL, scheduler.timeUntilNext(100));
+    CHECK_EQUAL(1U, scheduler.run(150));
+    CHECK(scheduler.remove(disabled[1999]));
+}
+
+TEST(schedulerZeroIntervalDoesNotStarveOthers) {
+    int ids[] = {1, 2};
+    Delay control(0);
+    Delay telemetry(100);
+    control.setCallback(record, &ids[0]);
+    telemetry.setCallback(record, &ids[1]);
+    control.setPriority(DelayPriority::High);
+
+    DelayScheduler scheduler;
+    scheduler.add(control);
+    scheduler.add(telemetry);
+
+    // The zero interval fires once per pass, the normal class still runs.
+    orderSize = 0;
+    CHECK_EQUAL(1U, scheduler.run(50));
+    CHECK_EQUAL(2U, scheduler.run(100));
+    CHECK_EQUAL(3, orderSize);
+    CHECK_EQUAL(1, order[0]);
+    CHECK_EQUAL(1, order[1]);
+    CHECK_EQUAL(2, order[2]);
+}
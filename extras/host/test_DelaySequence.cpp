@@ -0,0 +1,78 @@
+#include "DelaySequence.h"
+#include "test.h"
+
+static char trace[16];
+static uint8_t traceSize = 0;
+
+static void stepA() {
+    trace[traceSize++] = 'A';
+}
+
+static void stepB() {
+    trace[traceSize++] = 'B';
+}
+
+static void stepC() {
+    trace[traceSize++] = 'C';
+}
+
+static const DelayStep steps[] PROGMEM = {
+    {100, stepA},
+    {200, stepB},
+    {0, stepC},
+    {50, nullptr},
+};
+
+TEST(sequenceRunsStepsInOrder) {
+    traceSize = 0;
+    DelaySequence sequence(steps);
+    CHECK_EQUAL(4, sequence.getSize());
+    CHECK(!sequence.isStarted());
+
+    sequence.start(0);
+    CHECK_EQUAL(1, traceSize);
+    CHECK(!sequence.update(99));
+
+    CHECK(sequence.update(100));
+    CHECK_EQUAL(1, sequence.getStep());
+    CHECK_EQUAL(2, traceSize);
+
+    // C has no duration, so the wait step follows at once.
+    CHECK(sequence.update(300));
+    CHECK_EQUAL(3, sequence.getStep());
+    CHECK_EQUAL(3, traceSize);
+
+    CHECK(!sequence.update(349));
+    CHECK(sequence.update(350));
+    CHECK(!sequence.isStarted());
+    CHECK_EQUAL('A', trace[0]);
+    CHECK_EQUAL('B', trace[1]);
+    CHECK_EQUAL('C', trace[2]);
+}
+
+TEST(sequenceKeepsPlannedTimes) {
+    traceSize = 0;
+    DelaySequence sequence(steps);
+    sequence.start(0);
+
+    // A late poll runs the overdue steps, the rest keeps its times.
+    CHECK(sequence.update(320));
+    CHECK_EQUAL(3, sequence.getStep());
+    CHECK(!sequence.update(349));
+    CHECK(sequence.update(350));
+}
+
+TEST(sequenceLoops) {
+    traceSize = 0;
+    DelaySequence sequence(steps, true);
+    sequence.start(0);
+
+    sequence.update(350);
+    CHECK(sequence.isStarted());
+    CHECK_EQUAL(0, sequence.getStep());
+    CHECK_EQUAL(4, traceSize);
+
+    sequence.stop();
+    CHECK(!sequence.update(1000));
+    CHECK_EQUAL(4, traceSize);
+}
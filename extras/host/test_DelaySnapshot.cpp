@@ -0,0 +1,50 @@
+#include "Delay.h"
+#include "test.h"
+
+TEST(snapshotHasFixedLayout) {
+    CHECK_EQUAL(24U, sizeof(DelaySnapshot));
+}
+
+TEST(snapshotContinuesIntervalAfterSleep) {
+    Delay report(3600000UL);
+    report.isOver(3600000UL);
+    DelaySnapshot snapshot = report.serialize(3600000UL + 1000000UL);
+
+    // Slept for 2000 s, then 500 s since the boot.
+    Delay restored(3600000UL);
+    CHECK(restored.restore(snapshot, 2000000UL, 500000UL));
+    CHECK_EQUAL(1UL, restored.getCount());
+    CHECK_EQUAL(3500000UL, restored.getDelta(500000UL));
+    CHECK_EQUAL(100000UL, restored.remainingTime(500000UL));
+    CHECK(restored.isOver(600000UL));
+}
+
+TEST(snapshotKeepsModeAndSuspend) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic, DelayCatchUp::Coalesce);
+    delay.suspend(1000, true, 40);
+    DelaySnapshot snapshot = delay.serialize(140);
+
+    Delay restored;
+    CHECK(restored.restore(snapshot, 0, 0));
+    CHECK(restored.getMode() == DelayMode::Periodic);
+    CHECK(restored.getCatchUp() == DelayCatchUp::Coalesce);
+    CHECK(!restored.isActive);
+
+    // 900 of suspend left, then the 60 left in the interval.
+    CHECK_EQUAL(960UL, restored.remainingTime(0));
+}
+
+TEST(snapshotRejectsCorruption) {
+    Delay delay(100);
+    DelaySnapshot snapshot = delay.serialize(0);
+    snapshot.interval ^= 1;
+
+    Delay restored(500);
+    CHECK(!restored.restore(snapshot, 0, 0));
+    CHECK_EQUAL(500UL, restored.getInterval());
+
+    snapshot = delay.serialize(0);
+    snapshot.version = 0;
+    CHECK(!restored.restore(snapshot, 0, 0));
+}
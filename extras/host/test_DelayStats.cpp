@@ -0,0 +1,47 @@
+#include "Delay.h"
+#include "test.h"
+
+#if DELAY_ENABLE_STATS
+static void slowCallback() {
+    advanceMicros(100);
+}
+
+TEST(statsLateness) {
+    Delay delay(100);
+
+    delay.isOver(105);
+    delay.isOver(205);
+    delay.isOver(325);
+
+    const DelayStats& stats = delay.getStats();
+    CHECK_EQUAL(3UL, stats.triggers);
+    CHECK_EQUAL(0UL, stats.minLateness);
+    CHECK_EQUAL(20UL, stats.maxLateness);
+    CHECK_EQUAL(8UL, stats.getMeanLateness());
+
+    delay.resetStats();
+    CHECK_EQUAL(0UL, delay.getStats().triggers);
+}
+
+TEST(statsMissedPeriods) {
+    Delay delay(100);
+    delay.setMode(DelayMode::Periodic);
+
+    delay.isOver(350);
+    CHECK_EQUAL(2UL, delay.getStats().missed);
+    CHECK_EQUAL(250UL, delay.getStats().maxLateness);
+}
+
+TEST(statsCallbackTime) {
+    Delay delay(10);
+    delay.setCallback(slowCallback);
+
+    delay.execCallback(10);
+    delay.execCallback(20);
+
+    // 100 us falls into the [64, 256) bucket.
+    const DelayStats& stats = delay.getStats();
+    CHECK_EQUAL(100UL, stats.maxCallbackTime);
+    CHECK_EQUAL(2, stats.callbackHistogram[3]);
+}
+#endif
@@ -0,0 +1,80 @@
+#include "DelayTable.h"
+#include "test.h"
+
+static char trace[16];
+static uint8_t traceSize = 0;
+
+static void entryA() {
+    trace[traceSize++] = 'A';
+}
+
+static void entryB() {
+    trace[traceSize++] = 'B';
+}
+
+static void entryC() {
+    trace[traceSize++] = 'C';
+}
+
+typedef DelayTable<DelayEntry<100, entryA>,
+                   DelayEntry<30, entryB, DelayMode::Periodic>,
+                   DelayEntry<100, entryC, DelayMode::OneShot>>
+    TestTable;
+
+TEST(tableKeepsOnlyTimestamps) {
+    CHECK_EQUAL(3, TestTable::getSize());
+    CHECK(sizeof(TestTable) <= 4 * sizeof(unsigned long));
+}
+
+TEST(tableFiresInEntryOrder) {
+    traceSize = 0;
+    TestTable table;
+    table.start(0);
+
+    CHECK_EQUAL(0u, table.run(29));
+    CHECK_EQUAL(1u, table.run(30));
+    CHECK_EQUAL(0u, table.run(59));
+    CHECK_EQUAL(1u, table.run(60));
+
+    // A at 100, B at 90 seen late, C once.
+    CHECK_EQUAL(3u, table.run(100));
+    CHECK_EQUAL(5, traceSize);
+    CHECK_EQUAL('A', trace[2]);
+    CHECK_EQUAL('B', trace[3]);
+    CHECK_EQUAL('C', trace[4]);
+    CHECK(!table.isActive(2));
+}
+
+TEST(tableModesMoveTimestamps) {
+    traceSize = 0;
+    TestTable table;
+    table.start(0);
+
+    // Polled late: B keeps its phase and skips the missed periods, A
+    // restarts at the poll and C does not fire again.
+    CHECK_EQUAL(3u, table.run(175));
+    CHECK_EQUAL(0u, table.run(179));
+    CHECK_EQUAL(1u, table.run(180));
+    CHECK_EQUAL(0u, table.run(209));
+    CHECK_EQUAL(1u, table.run(210));
+    CHECK_EQUAL(0u, table.run(239));
+    CHECK_EQUAL(2u, table.run(275));
+    CHECK_EQUAL(2u, table.run(500));
+    CHECK_EQUAL('C', trace[2]);
+    CHECK_EQUAL(9, traceSize);
+}
+
+TEST(tableEnableAndDisable) {
+    traceSize = 0;
+    TestTable table;
+    table.start(0);
+
+    table.disable(0);
+    table.disable(1);
+    CHECK_EQUAL(1u, table.run(100));
+    CHECK_EQUAL('C', trace[0]);
+
+    table.enable(2, 100);
+    CHECK_EQUAL(0u, table.run(199));
+    CHECK_EQUAL(1u, table.run(200));
+}
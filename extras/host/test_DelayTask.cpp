@@ -0,0 +1,128 @@
+#include "DelayTask.h"
+#include "test.h"
+
+#if defined(DELAY_HAS_COROUTINES)
+
+static char trace[16];
+static uint8_t traceSize = 0;
+
+static DelayTask blink(char on, char off, unsigned long period) {
+    for (;;) {
+        trace[traceSize++] = on;
+        co_await Delay::for_ms(period);
+        trace[traceSize++] = off;
+        co_await Delay::for_ms(period);
+    }
+}
+
+static DelayTask countdown(uint8_t steps) {
+    while (steps-- > 0) {
+        trace[traceSize++] = '0' + steps;
+        co_await Delay::for_ms(100);
+    }
+}
+
+TEST(taskResumesAfterAwait) {
+    traceSize = 0;
+    DelayScheduler scheduler;
+    DelayExecutor executor(scheduler);
+
+    CHECK(executor.spawn(blink('A', 'a', 100)));
+    CHECK_EQUAL(1, traceSize);
+    CHECK_EQUAL('A', trace[0]);
+
+    setMillis(99);
+    executor.run(99);
+    CHECK_EQUAL(1, traceSize);
+
+    setMillis(100);
+    CHECK_EQUAL(1u, executor.run(100));
+    CHECK_EQUAL(2, traceSize);
+    CHECK_EQUAL('a', trace[1]);
+    CHECK_EQUAL(100u, scheduler.timeUntilNext(100));
+}
+
+TEST(tasksInterleaveOnScheduler) {
+    traceSize = 0;
+    DelayScheduler scheduler;
+    DelayExecutor executor(scheduler);
+
+    executor.spawn(blink('A', 'a', 100));
+    executor.spawn(blink('B', 'b', 150));
+    CHECK_EQUAL(2, executor.getActive());
+
+    for (unsigned long now = 0; now <= 300; now += 10) {
+        setMillis(now);
+        executor.run(now);
+    }
+
+    // A at 0, 100, 200, 300 and B at 0, 150, 300.
+    CHECK_EQUAL(7, traceSize);
+    CHECK_EQUAL('A', trace[0]);
+    CHECK_EQUAL('B', trace[1]);
+    CHECK_EQUAL('a', trace[2]);
+    CHECK_EQUAL('b', trace[3]);
+    CHECK_EQUAL('A', trace[4]);
+}
+
+TEST(finishedTaskFreesFrame) {
+    traceSize = 0;
+    DelayScheduler scheduler;
+    DelayExecutor executor(scheduler);
+
+    CHECK(executor.spawn(countdown(2)));
+    CHECK_EQUAL(1, delayTaskFrames.getUsed());
+
+    setMillis(100);
+    executor.run(100);
+    CHECK_EQUAL(1, executor.getActive());
+
+    setMillis(200);
+    executor.run(200);
+    CHECK_EQUAL(0, executor.getActive());
+    CHECK_EQUAL(0, delayTaskFrames.getUsed());
+    CHECK_EQUAL(0u, scheduler.getSize());
+    CHECK_EQUAL(2, traceSize);
+}
+
+TEST(taskWithoutAwaitEndsInSpawn) {
+    traceSize = 0;
+    DelayScheduler scheduler;
+    DelayExecutor executor(scheduler);
+
+    CHECK(executor.spawn(countdown(0)));
+    CHECK_EQUAL(0, executor.getActive());
+    CHECK_EQUAL(0, delayTaskFrames.getUsed());
+}
+
+TEST(fullFramePoolGivesEmptyTask) {
+    traceSize = 0;
+    DelayScheduler scheduler;
+    {
+        DelayExecutor executor(scheduler);
+        for (uint8_t i = 0; i < DELAY_TASK_FRAMES; i++) {
+            CHECK(executor.spawn(blink('A', 'a', 100)));
+        }
+
+        DelayTask extra = blink('B', 'b', 100);
+        CHECK(!extra);
+        CHECK(!executor.spawn(blink('B', 'b', 100)));
+        CHECK_EQUAL(DELAY_TASK_FRAMES, delayTaskFrames.getUsed());
+    }
+
+    // The executor destroys the running tasks and their timers.
+    CHECK_EQUAL(0, delayTaskFrames.getUsed());
+    CHECK_EQUAL(0u, scheduler.getSize());
+}
+
+TEST(unspawnedTaskIsDestroyed) {
+    {
+        DelayTask task = countdown(3);
+        CHECK(task);
+        CHECK_EQUAL(1, delayTaskFrames.getUsed());
+    }
+
+    CHECK_EQUAL(0, delayTaskFrames.getUsed());
+}
+
+#endif  // DELAY_HAS_COROUTINES
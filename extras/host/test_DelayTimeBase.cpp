@@ -0,0 +1,69 @@
+#include "BasicDelay.h"
+#include "DelayScheduler.h"
+#include "DelayTimeBase.h"
+#include "test.h"
+
+// The counters are shared by all test cases, so the checks compare two
+// readings instead of absolute values.
+
+TEST(timeBaseKeepsMillisLowBits) {
+    setMillis(123456);
+    CHECK_EQUAL(123456UL, (unsigned long)(DelayTimeBase::millis64() &
+                                          0xFFFFFFFFUL));
+}
+
+TEST(timeBaseExtendsMillisRollover) {
+    setMillis(0xFFFFFFF0UL);
+    uint64_t before = DelayTimeBase::millis64();
+
+    // millis() wraps on a 32-bit target, only the low bits are read.
+    setMillis(0x100000010UL);
+    uint64_t after = DelayTimeBase::millis64();
+    CHECK(after - before == 0x20);
+}
+
+TEST(timeBaseExtendsMicrosRollover) {
+    setMicros(0xFFFFFF00UL);
+    uint64_t before = DelayTimeBase::micros64();
+
+    setMicros(0x100000100UL);
+    uint64_t after = DelayTimeBase::micros64();
+    CHECK(after - before == 0x200);
+}
+
+TEST(timeBaseSharedBySchedulerAndLongDelay) {
+    setMillis(0xFFFFFF00UL);
+    LongDelay delay(0x200);
+
+    // Only the scheduler reads the clock around the rollover, the
+    // LongDelay still sees it through the shared counter.
+    DelayScheduler scheduler;
+    setMillis(0x100000000UL);
+    scheduler.run();
+
+    setMillis(0x1FFFFFFF0UL);
+    CHECK(delay.isOver());
+}
+
+TEST(timeBaseDoesNotShiftSchedulerTime) {
+    // A high word left by an earlier reading must not reach the
+    // millis() timestamps of the objects.
+    setMillis(0xFFFFFFFFUL);
+    DelayTimeBase::millis64();
+    setMillis(0x100000000UL);
+    DelayTimeBase::millis64();
+
+    setMillis(1000);
+    DelayTimeBase::millis64();
+    setMillis(0);
+
+    Delay delay(500);
+    DelayScheduler scheduler;
+    scheduler.add(delay);
+    CHECK_EQUAL(0U, scheduler.run());
+    CHECK_EQUAL(500UL, scheduler.timeUntilNext());
+    CHECK_EQUAL(500UL, scheduler.timeUntilWakeup());
+
+    setMillis(500);
+    CHECK_EQUAL(1U, scheduler.run());
+}
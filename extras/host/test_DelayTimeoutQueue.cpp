@@ -0,0 +1,174 @@
+#include <limits.h>
+
+#include "DelayTimeoutQueue.h"
+#include "test.h"
+
+static unsigned int expiredCount = 0;
+
+static void onExpired(void* context) {
+    expiredCount++;
+    *static_cast<unsigned long*>(context) = millis();
+}
+
+TEST(timeoutExpiresAtDeadline) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout timeout;
+    DelayTimeout* out[4];
+
+    queue.arm(timeout, 10, 0);
+    CHECK(timeout.isArmed());
+    CHECK_EQUAL(10u, timeout.getDeadline());
+    CHECK_EQUAL(0, queue.pollExpired(9, out, 4));
+
+    CHECK_EQUAL(1, queue.pollExpired(10, out, 4));
+    CHECK(out[0] == &timeout);
+    CHECK(!timeout.isArmed());
+    CHECK(queue.isEmpty());
+}
+
+TEST(timeoutRearmMovesDeadline) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout timeout;
+    DelayTimeout* out[4];
+
+    queue.arm(timeout, 10, 0);
+    queue.arm(timeout, 10, 8);
+    CHECK_EQUAL(0, queue.pollExpired(12, out, 4));
+    CHECK_EQUAL(1, queue.pollExpired(18, out, 4));
+
+    queue.arm(timeout, 10, 20);
+    timeout.cancel();
+    CHECK(!timeout.isArmed());
+    CHECK_EQUAL(0, queue.pollExpired(40, out, 4));
+}
+
+TEST(timeoutBatchInDeadlineOrder) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout a, b, c, d;
+    DelayTimeout* out[4];
+
+    // b and c share a slot but are armed out of order.
+    queue.arm(a, 30, 0);
+    queue.arm(c, 14, 0);
+    queue.arm(b, 13, 0);
+    queue.arm(d, 5, 0);
+
+    CHECK_EQUAL(4, queue.pollExpired(40, out, 4));
+    CHECK(out[0] == &d);
+    CHECK(out[1] == &b);
+    CHECK(out[2] == &c);
+    CHECK(out[3] == &a);
+}
+
+TEST(timeoutPartialBatchKeepsRest) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout a, b, c;
+    DelayTimeout* out[2];
+
+    queue.arm(a, 5, 0);
+    queue.arm(b, 9, 0);
+    queue.arm(c, 20, 0);
+
+    CHECK_EQUAL(2, queue.pollExpired(30, out, 2));
+    CHECK(out[0] == &a);
+    CHECK(out[1] == &b);
+    CHECK(c.isArmed());
+    CHECK_EQUAL(1, queue.pollExpired(30, out, 2));
+    CHECK(out[0] == &c);
+}
+
+TEST(timeoutLongerThanTurn) {
+    // One turn of the wheel is 64 ms.
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout timeout;
+    DelayTimeout* out[1];
+
+    queue.arm(timeout, 200, 0);
+    for (unsigned long now = 0; now < 200; now += 3) {
+        CHECK_EQUAL(0, queue.pollExpired(now, out, 1));
+    }
+
+    CHECK_EQUAL(1, queue.pollExpired(200, out, 1));
+}
+
+TEST(timeoutAfterLongPause) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout a, b;
+    DelayTimeout* out[2];
+
+    queue.arm(a, 10, 0);
+    queue.arm(b, 100, 0);
+    CHECK_EQUAL(2, queue.pollExpired(1000, out, 2));
+    CHECK(out[0] == &a);
+    CHECK(out[1] == &b);
+}
+
+TEST(timeoutSurvivesRollover) {
+    unsigned long start = ULONG_MAX - 5;
+    DelayTimeoutQueue<16, 4> queue(start);
+    DelayTimeout timeout;
+    DelayTimeout* out[1];
+
+    queue.arm(timeout, 10, start);
+    CHECK_EQUAL(0, queue.pollExpired(ULONG_MAX, out, 1));
+    CHECK_EQUAL(0, queue.pollExpired(3, out, 1));
+    CHECK_EQUAL(1, queue.pollExpired(4, out, 1));
+}
+
+TEST(timeoutRunCallsCallbacks) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    unsigned long firedAt[10];
+    DelayTimeout timeouts[10];
+    expiredCount = 0;
+
+    for (uint8_t i = 0; i < 10; i++) {
+        timeouts[i].setCallback(onExpired, &firedAt[i]);
+        queue.arm(timeouts[i], 10 + i, 0);
+    }
+
+    setMillis(15);
+    CHECK_EQUAL(6u, queue.run(15));
+    setMillis(30);
+    CHECK_EQUAL(4u, queue.run(30));
+    CHECK_EQUAL(10u, expiredCount);
+    CHECK_EQUAL(15u, firedAt[0]);
+    CHECK_EQUAL(30u, firedAt[9]);
+}
+
+TEST(timeoutDestructorDisarms) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    DelayTimeout* out[1];
+    {
+        DelayTimeout timeout;
+        queue.arm(timeout, 10, 0);
+        CHECK(!queue.isEmpty());
+    }
+
+    CHECK(queue.isEmpty());
+    CHECK_EQUAL(0, queue.pollExpired(20, out, 1));
+}
+
+static DelayTimeout* cancelTarget = nullptr;
+
+static void onExpiredCancel(void* context) {
+    expiredCount++;
+    (void)context;
+    cancelTarget->cancel();
+}
+
+TEST(timeoutCancelledInBatchIsSkipped) {
+    DelayTimeoutQueue<16, 4> queue(0);
+    unsigned long firedAt = 0;
+    DelayTimeout first(onExpiredCancel, nullptr);
+    DelayTimeout second(onExpired, &firedAt);
+    cancelTarget = &second;
+    expiredCount = 0;
+
+    queue.arm(first, 10, 0);
+    queue.arm(second, 11, 0);
+    CHECK_EQUAL(1u, queue.run(20));
+    CHECK_EQUAL(1u, expiredCount);
+    CHECK_EQUAL(0u, firedAt);
+    CHECK(!second.isArmed());
+    CHECK(queue.isEmpty());
+}
@@ -0,0 +1,61 @@
+#include <limits.h>
+
+#include "RateLimiter.h"
+#include "test.h"
+
+TEST(rateLimiterAllowsBurst) {
+    RateLimiter limiter(3, 100);
+    CHECK(limiter.tryAcquire(1, 0));
+    CHECK(limiter.tryAcquire(2, 0));
+    CHECK(!limiter.tryAcquire(1, 0));
+    CHECK(!limiter.tryAcquire(1, 99));
+    CHECK(limiter.tryAcquire(1, 100));
+    CHECK(!limiter.tryAcquire(1, 150));
+}
+
+TEST(rateLimiterKeepsPartialInterval) {
+    RateLimiter limiter(2, 100);
+    limiter.tryAcquire(2, 0);
+
+    // Polls off the interval grid do not slow the rate down.
+    CHECK_EQUAL(1, limiter.getTokens(150));
+    CHECK(limiter.tryAcquire(1, 150));
+    CHECK_EQUAL(50u, limiter.timeUntilAvailable(1, 150));
+    CHECK_EQUAL(150u, limiter.timeUntilAvailable(2, 150));
+    CHECK(limiter.tryAcquire(1, 200));
+}
+
+TEST(rateLimiterCapsAtCapacity) {
+    RateLimiter limiter(4, 10);
+    limiter.tryAcquire(4, 0);
+    CHECK_EQUAL(4, limiter.getTokens(100000));
+    CHECK(!limiter.tryAcquire(5, 100000));
+    CHECK_EQUAL(ULONG_MAX, limiter.timeUntilAvailable(5, 100000));
+
+    // A full bucket does not save up time for later.
+    CHECK(limiter.tryAcquire(4, 100000));
+    CHECK_EQUAL(0, limiter.getTokens(100009));
+}
+
+TEST(rateLimiterSurvivesRollover) {
+    setMillis(ULONG_MAX - 50);
+    RateLimiter limiter(1, 100);
+    CHECK(limiter.tryAcquire());
+    CHECK(!limiter.tryAcquire(1, ULONG_MAX));
+    CHECK(limiter.tryAcquire(1, 49));
+}
+
+TEST(leakyBucketDrains) {
+    LeakyBucket bucket(3, 100);
+    CHECK(bucket.tryAdd(3, 0));
+    CHECK(!bucket.tryAdd(1, 50));
+    CHECK_EQUAL(2, bucket.getLevel(120));
+    CHECK(bucket.tryAdd(1, 120));
+    CHECK(!bucket.tryAdd(1, 199));
+    CHECK(bucket.tryAdd(1, 200));
+    CHECK_EQUAL(0, bucket.getLevel(10000));
+
+    bucket.tryAdd(2, 10000);
+    bucket.reset(10000);
+    CHECK_EQUAL(0, bucket.getLevel(10000));
+}
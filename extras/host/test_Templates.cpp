@@ -0,0 +1,79 @@
+#include "BasicDelay.h"
+#include "StaticDelay.h"
+#include "test.h"
+
+TEST(staticDelayIsSingleTimestamp) {
+    CHECK_EQUAL(sizeof(unsigned long), sizeof(StaticDelay<500>));
+}
+
+TEST(staticDelayTriggers) {
+    StaticDelay<100, DelayFeature::Count> delay;
+
+    CHECK(!delay.isOver(99));
+    CHECK(delay.isOver(100));
+    CHECK(delay.isDone(200));
+    CHECK_EQUAL(2UL, delay.getCount());
+}
+
+TEST(staticDelaySuspendContinues) {
+    StaticDelay<100, DelayFeature::Suspend> delay;
+
+    delay.suspend(200, true, 40);
+    CHECK(!delay.isOver(240));
+    CHECK(!delay.isOver(299));
+    CHECK(delay.isOver(300));
+}
+
+TEST(basicDelayShortWraps) {
+    setMillis(65000);
+    ShortDelay delay(1000);
+
+    // 66000 is 464 after the 16-bit wrap.
+    setMillis(65999);
+    CHECK(!delay.isOver());
+
+    setMillis(66000);
+    CHECK(delay.isOver());
+}
+
+TEST(basicDelayLongNeverWraps) {
+    LongDelay delay(1000);
+
+    setMillis(999);
+    CHECK(!delay.isOver());
+
+    setMillis(1000);
+    CHECK(delay.isOver());
+}
+
+// A 12-bit counter, as a stand-in for a hardware timer.
+static uint16_t counter = 0;
+
+struct CounterClock {
+    static constexpr uint16_t mask = 0x0FFF;
+
+    static uint16_t now() {
+        return counter & mask;
+    }
+};
+
+TEST(basicDelayCustomClockWraps) {
+    counter = 4000;
+    BasicDelay<uint16_t, uint8_t, CounterClock> delay(200);
+
+    counter = 4000 + 199;
+    CHECK(!delay.isOver());
+
+    counter = 4000 + 200;
+    CHECK(delay.isOver());
+}
+
+TEST(microDelayUsesMicros) {
+    MicroDelay delay(200);
+
+    advanceMicros(199);
+    CHECK(!delay.isOver());
+
+    advanceMicros(1);
+    CHECK(delay.isOver());
+}
@@ -0,0 +1,466 @@
+/**
+ * @brief Provides a lock-free Delay that can be shared between tasks and
+ * cores.
+ *
+ */
+#ifndef _ATOMIC_DELAY_H
+#define _ATOMIC_DELAY_H
+
+#include "Delay.h"
+
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define DELAY_HAS_ATOMIC 1
+#endif
+#endif
+
+#if defined(DELAY_HAS_ATOMIC)
+
+#include <atomic>
+
+/**
+ * @brief This class is a Delay whose state is kept in atomics, so it can be
+ * polled and controlled from several tasks or cores at once.
+ * @class AtomicDelay
+ *
+ * The state and a generation counter share one 32-bit atomic word, which
+ * every control operation and every claimed expiry moves forward with a
+ * compare-and-swap. An expiry is claimed by swapping the word seen before
+ * the deadline check, so exactly one of the tasks polling the same object
+ * sees `true`, and none after disable() or suspend() has returned. No
+ * mutex is taken on any path. Requires the `<atomic>` header (ESP32,
+ * RP2040 and other 32-bit cores); only 32-bit atomics are used, as the
+ * Xtensa cores of the ESP32 have no lock-free compare-and-swap of other
+ * sizes.
+ *
+ * A zero interval expires at most once per millisecond, so the claims
+ * of the contenders are always told apart by the timestamp.
+ *
+ * @code
+ * AtomicDelay sharedDelay(500);
+ *
+ * void taskOnCore0(void*) {
+ *   for (;;) {
+ *     if (sharedDelay.isOver()) {
+ *       // Runs on exactly one core per expiry.
+ *     }
+ *   }
+ * }
+ *
+ * void taskOnCore1(void*) {
+ *   for (;;) {
+ *     if (sharedDelay.isOver()) {
+ *       // ...
+ *     }
+ *
+ *     if (shouldPause()) {
+ *       sharedDelay.suspend(1000);
+ *     }
+ *   }
+ * }
+ * @endcode
+ */
+class AtomicDelay {
+private:
+    /**
+     * @brief The states of the object, in the low bits of `state`.
+     *
+     * `Resuming` is held by the single task that ends a suspend, while it
+     * restores the timestamp, and `Firing` by the single task that has
+     * claimed an expiry, while it moves the timestamp. Other tasks never
+     * wait for them.
+     */
+    enum State : uint32_t {
+        Disabled,
+        Active,
+        Suspended,
+        Resuming,
+        Firing
+    };
+
+    /**
+     * @brief The bits of the state in `state`.
+     */
+    static constexpr uint32_t StateMask = 0x07;
+
+    /**
+     * @brief The step of the generation counter in the high bits of
+     * `state`.
+     */
+    static constexpr uint32_t Generation = StateMask + 1;
+
+    /**
+     * @brief The state of the object and the generation counter.
+     */
+    std::atomic<uint32_t> state;
+
+    /**
+     * @brief The number of times the object has been triggered.
+     */
+    std::atomic<uint32_t> count;
+
+    /**
+     * @brief The delay interval in milliseconds.
+     */
+    std::atomic<uint32_t> interval;
+
+    /**
+     * @brief The last time (in milliseconds) the object was triggered,
+     * enabled or suspended.
+     */
+    std::atomic<uint32_t> timestamp;
+
+    /**
+     * @brief The suspend time in milliseconds.
+     */
+    std::atomic<uint32_t> suspendTime;
+
+    /**
+     * @brief The time elapsed in the interval before the object was
+     * suspended with continuation.
+     */
+    std::atomic<uint32_t> suspendDelta;
+
+    /**
+     * @brief The callback function to be invoked when the timer expires.
+     */
+    std::atomic<CallbackFunction> callbackFunction;
+
+    /**
+     * @brief Builds the state word that follows the given one.
+     *
+     * @param[in] current The current state word.
+     * @param[in] next The new state.
+     *
+     * @return The new state word, one generation later.
+     */
+    static uint32_t advance(uint32_t current, State next) {
+        return ((current & ~StateMask) + Generation) | next;
+    }
+
+    /**
+     * @brief Moves the object to the given state, whatever the current
+     * one, and starts a new generation.
+     *
+     * @param[in] next The new state.
+     */
+    void setState(State next) {
+        uint32_t current = this->state.load(std::memory_order_relaxed);
+        while (!this->state.compare_exchange_weak(current,
+                                                  advance(current, next))) {
+        }
+    }
+
+    /**
+     * @brief Ends an expired suspend. Only one task wins the transition.
+     *
+     * The transition is claimed from the state word seen before the times
+     * were read, so a suspend issued again in the meantime is not ended
+     * early. The timestamp is replaced only if nobody has written it since.
+     *
+     * @param[in] current The state word read by the caller.
+     * @param[in] now The current time in milliseconds.
+     */
+    void pollSuspend(uint32_t current, uint32_t now) {
+        uint32_t start = this->timestamp.load();
+        uint32_t time = this->suspendTime.load();
+        uint32_t delta = this->suspendDelta.load();
+        if (now - start < time) {
+            return;
+        }
+
+        uint32_t resuming = advance(current, Resuming);
+        if (!this->state.compare_exchange_strong(current, resuming)) {
+            // The object was changed or resumed by another task.
+            return;
+        }
+
+        bool isMoved =
+            this->timestamp.compare_exchange_strong(start, now - delta);
+
+        // A lost swap means a control operation has taken over, its state
+        // is kept. Otherwise the object is active, or suspended again if
+        // the timestamp was restarted under it.
+        this->state.compare_exchange_strong(
+            resuming, advance(resuming, isMoved ? Active : Suspended));
+    }
+
+public:
+    /**
+     * @brief Constructs a new AtomicDelay object.
+     *
+     * @param[in] interval The delay time in milliseconds. Defaults to 0.
+     * @param[in] isActive Indicates whether the timer is active.
+     */
+    AtomicDelay(uint32_t interval = 0, bool isActive = true)
+        : state(isActive ? Active : Disabled),
+          count(0),
+          interval(interval),
+          timestamp(millis()),
+          suspendTime(0),
+          suspendDelta(0),
+          callbackFunction(nullptr) {}
+
+    AtomicDelay(const AtomicDelay&) = delete;
+    AtomicDelay& operator=(const AtomicDelay&) = delete;
+
+    /**
+     * @brief Enables the object and cancels any active suspend state.
+     */
+    void enable() {
+        this->enable(millis());
+    }
+
+    /**
+     * @brief Enables the object using the given current time.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void enable(uint32_t now) {
+        this->timestamp.store(now);
+        this->setState(Active);
+    }
+
+    /**
+     * @brief Disables the object and cancels any active suspend state.
+     */
+    void disable() {
+        this->setState(Disabled);
+    }
+
+    /**
+     * @brief Suspends the object for a specified amount of time.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * milliseconds.
+     * @param[in] shouldContinue (Optional) If set to `true`, the timer will
+     * continue counting from where it left off before being suspended.
+     */
+    void suspend(uint32_t suspendTime, bool shouldContinue = false) {
+        this->suspend(suspendTime, shouldContinue, millis());
+    }
+
+    /**
+     * @brief Suspends the object using the given current time.
+     *
+     * The suspend parameters are published before the state, and the new
+     * generation fails the claims of tasks that read the old ones.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * milliseconds.
+     * @param[in] shouldContinue If set to `true`, the timer will continue
+     * counting from where it left off before being suspended.
+     * @param[in] now The current time in milliseconds.
+     */
+    void suspend(uint32_t suspendTime, bool shouldContinue, uint32_t now) {
+        uint32_t delta = 0;
+        if (shouldContinue) {
+            delta = now - this->timestamp.load();
+        }
+
+        this->suspendDelta.store(delta);
+        this->suspendTime.store(suspendTime);
+        this->timestamp.store(now);
+        this->setState(Suspended);
+    }
+
+    /**
+     * @brief Sets the delay interval and resets the timer.
+     *
+     * @param[in] interval The new delay time in milliseconds.
+     */
+    void setInterval(uint32_t interval) {
+        this->interval.store(interval, std::memory_order_relaxed);
+        this->timestamp.store(millis(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Retrieves the configured delay interval.
+     *
+     * @return The configured delay time in milliseconds.
+     */
+    uint32_t getInterval() {
+        return this->interval.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Checks if the object is active.
+     *
+     * @retval true If the object is active.
+     * @retval false If it is disabled or suspended.
+     */
+    bool isEnabled() {
+        uint32_t current = this->state.load() & StateMask;
+        return current == Active || current == Firing;
+    }
+
+    /**
+     * @brief Checks if the object is suspended.
+     *
+     * @retval true If the object is suspended.
+     * @retval false otherwise.
+     */
+    bool isSuspended() {
+        uint32_t current = this->state.load() & StateMask;
+        return current == Suspended || current == Resuming;
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired.
+     *
+     * @retval true if the delay interval has expired and this task has
+     * claimed the expiry.
+     * @retval false otherwise.
+     */
+    bool isOver() {
+        return this->isOver(millis());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time.
+     *
+     * The active, not-due case costs three atomic loads and a compare.
+     * When the interval has expired, the state word read first is swapped
+     * to `Firing`, so only one task can claim the expiry, and a disable()
+     * or suspend() in between fails the swap. The claimer then moves the
+     * timestamp to `now` and returns `true` only if no control operation
+     * has replaced its state in the meantime.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true if the delay interval has expired and this task has
+     * claimed the expiry.
+     * @retval false otherwise.
+     */
+    bool isOver(uint32_t now) {
+        uint32_t current = this->state.load(std::memory_order_acquire);
+        if ((current & StateMask) != Active) {
+            if ((current & StateMask) == Suspended) {
+                this->pollSuspend(current, now);
+            }
+
+            return false;
+        }
+
+        uint32_t last = this->timestamp.load(std::memory_order_acquire);
+        uint32_t elapsed = now - last;
+        if (elapsed < this->interval.load(std::memory_order_relaxed) ||
+            elapsed == 0) {
+            return false;
+        }
+
+        uint32_t firing = advance(current, Firing);
+        if (!this->state.compare_exchange_strong(current, firing)) {
+            // Another task has claimed this expiry or changed the object.
+            return false;
+        }
+
+        // setInterval() may have restarted the timer since the check.
+        bool isMoved = this->timestamp.compare_exchange_strong(last, now);
+        if (!this->state.compare_exchange_strong(firing,
+                                                 advance(firing, Active))) {
+            // A control operation has replaced the state, it wins.
+            return false;
+        }
+
+        if (!isMoved) {
+            return false;
+        }
+
+        this->count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired and resets the timer.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone() {
+        return this->isOver(millis());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time and resets the timer.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone(uint32_t now) {
+        return this->isOver(now);
+    }
+
+    /**
+     * @brief Sets the callback function for the timer.
+     *
+     * @param[in] fn The callback function.
+     */
+    void setCallback(CallbackFunction fn) {
+        this->callbackFunction.store(fn, std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks if a callback function is set.
+     *
+     * @return True if a callback function is set, false otherwise.
+     */
+    bool hasCallback() {
+        return this->callbackFunction.load(std::memory_order_acquire) !=
+               nullptr;
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired.
+     *
+     * The callback runs on the task that has claimed the expiry.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback() {
+        return this->execCallback(millis());
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired
+     * using the given current time.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback(uint32_t now) {
+        CallbackFunction fn =
+            this->callbackFunction.load(std::memory_order_acquire);
+        if (fn != nullptr && this->isOver(now)) {
+            fn();
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Gets the number of times the object has become active.
+     *
+     * @return The number of times the object has been active.
+     */
+    uint32_t getCount() {
+        return this->count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Resets the activation count to zero.
+     */
+    void resetCount() {
+        this->count.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif  // DELAY_HAS_ATOMIC
+
+#endif  // _ATOMIC_DELAY_H
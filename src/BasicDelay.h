@@ -0,0 +1,509 @@
+/**
+ * @brief Provides a Delay with configurable time and counter widths and a
+ * configurable clock source.
+ *
+ */
+#ifndef _BASIC_DELAY_H
+#define _BASIC_DELAY_H
+
+#include "Delay.h"
+#include "DelayTimeBase.h"
+
+/**
+ * @brief Reads millis() at the width of the given time type.
+ *
+ * Narrower types keep the low bits of millis(), which wrap in the same way
+ * as the full counter, so the unsigned delta stays correct as long as the
+ * timer is polled at least once per wrap period (65.5 seconds for
+ * `uint16_t`).
+ *
+ * A clock source is any type with a static `now()` method returning
+ * `TimeT` and a static `mask` constant with the bits the counter actually
+ * uses. The delta between two readings is taken modulo `mask + 1`, so
+ * counters narrower than `TimeT` wrap correctly too.
+ *
+ * @code
+ * // Timer1 of the ATmega328P running at 2 MHz (prescaler 8).
+ * struct Timer1Clock {
+ *   static constexpr uint16_t mask = 0xFFFF;
+ *   static uint16_t now() { return TCNT1; }
+ * };
+ *
+ * BasicDelay<uint16_t, uint8_t, Timer1Clock> pulseDelay(400);  // 200 us
+ * @endcode
+ *
+ * @tparam TimeT The unsigned type of the timestamps.
+ */
+template <typename TimeT>
+struct DelayMillisClock {
+    /**
+     * @brief All bits of `TimeT` are used by the clock, up to the 32 bits
+     * it wraps at.
+     */
+    static constexpr TimeT mask =
+        static_cast<TimeT>(static_cast<uint32_t>(~static_cast<TimeT>(0)));
+
+    /**
+     * @brief Reads the current time.
+     *
+     * @return The current time in milliseconds, truncated to `TimeT`.
+     */
+    static TimeT now() {
+        return static_cast<TimeT>(millis());
+    }
+};
+
+/**
+ * @brief Reads a 64-bit millisecond time that never wraps, from the shared
+ * DelayTimeBase.
+ */
+template <>
+struct DelayMillisClock<uint64_t> {
+    static constexpr uint64_t mask = ~static_cast<uint64_t>(0);
+
+    /**
+     * @brief Reads the current time.
+     *
+     * @return The current time in milliseconds.
+     */
+    static uint64_t now() {
+        return DelayTimeBase::millis64();
+    }
+};
+
+/**
+ * @brief Reads micros() at the width of the given time type.
+ *
+ * micros() wraps every 71.6 minutes, so a 32-bit microsecond timer must be
+ * polled at least that often, and a `uint16_t` one every 65.5
+ * milliseconds.
+ *
+ * @tparam TimeT The unsigned type of the timestamps.
+ */
+template <typename TimeT>
+struct DelayMicrosClock {
+    /**
+     * @brief All bits of `TimeT` are used by the clock, up to the 32 bits
+     * it wraps at.
+     */
+    static constexpr TimeT mask =
+        static_cast<TimeT>(static_cast<uint32_t>(~static_cast<TimeT>(0)));
+
+    /**
+     * @brief Reads the current time.
+     *
+     * @return The current time in microseconds, truncated to `TimeT`.
+     */
+    static TimeT now() {
+        return static_cast<TimeT>(micros());
+    }
+};
+
+/**
+ * @brief Reads a 64-bit microsecond time that never wraps, from the shared
+ * DelayTimeBase.
+ */
+template <>
+struct DelayMicrosClock<uint64_t> {
+    static constexpr uint64_t mask = ~static_cast<uint64_t>(0);
+
+    /**
+     * @brief Reads the current time.
+     *
+     * @return The current time in microseconds.
+     */
+    static uint64_t now() {
+        return DelayTimeBase::micros64();
+    }
+};
+
+/**
+ * @brief This class is a Delay with configurable time and counter types.
+ * @class BasicDelay
+ *
+ * A `uint16_t` time type makes every poll a 2-byte subtraction and compare
+ * on 8-bit MCUs, for intervals up to 65.5 seconds. A `uint64_t` time type
+ * never wraps, for intervals longer than the 49.7-day millis() rollover.
+ *
+ * @code
+ * BasicDelay<uint16_t, uint8_t> blinkDelay(500);       // 12 bytes on AVR
+ * BasicDelay<uint64_t> reportDelay(60ULL * 86400000);  // 60 days
+ * @endcode
+ *
+ * The clock source is a policy, so the same class drives sub-millisecond
+ * work from micros() or a hardware counter. All times (interval, suspend
+ * time, delta) are then in the ticks of that clock.
+ *
+ * @code
+ * BasicDelay<uint32_t, uint32_t, DelayMicrosClock<uint32_t>> stepDelay(200);
+ * @endcode
+ *
+ * The methods have the same semantics as in Delay.
+ *
+ * @tparam TimeT The unsigned type of the interval and the timestamps.
+ * @tparam CountT The unsigned type of the trigger counter.
+ * @tparam Clock The clock source, DelayMillisClock by default.
+ */
+template <typename TimeT, typename CountT = TimeT,
+          typename Clock = DelayMillisClock<TimeT>>
+class BasicDelay {
+private:
+    /**
+     * @brief The number of times the object has been triggered.
+     */
+    CountT count = 0;
+
+    /**
+     * @brief The time interval (in clock ticks) after which the object
+     * becomes ready.
+     */
+    TimeT interval = 0;
+
+    /**
+     * @brief The last time (in clock ticks) the object was triggered or
+     * initialized.
+     */
+    TimeT timestamp = 0;
+
+    /**
+     * @brief The suspend time in clock ticks, zero if not suspended.
+     */
+    TimeT suspendTime = 0;
+
+    /**
+     * @brief The time elapsed in the interval before the object was
+     * suspended with continuation.
+     */
+    TimeT suspendDelta = 0;
+
+    /**
+     * @brief The callback function to be invoked when the timer expires.
+     */
+    CallbackFunction callbackFunction = nullptr;
+
+public:
+    /**
+     * @brief Indicates whether the timer is active.
+     */
+    bool isActive = true;
+
+    /**
+     * @brief Reads the current time of the clock used by the object.
+     *
+     * @return The current time in clock ticks.
+     */
+    static TimeT now() {
+        return Clock::now();
+    }
+
+    /**
+     * @brief Constructs a new BasicDelay object.
+     *
+     * @param[in] interval The delay time in clock ticks. Defaults to 0.
+     * @param[in] isActive Indicates whether the timer is active.
+     */
+    BasicDelay(TimeT interval = 0, bool isActive = true)
+        : interval(interval), timestamp(now()), isActive(isActive) {}
+
+    /**
+     * @brief Enables the object and cancels any active suspend state.
+     */
+    void enable() {
+        this->enable(now());
+    }
+
+    /**
+     * @brief Enables the object using the given current time.
+     *
+     * @param[in] now The current time in clock ticks.
+     */
+    void enable(TimeT now) {
+        this->isActive = true;
+        this->suspendTime = 0;
+        this->suspendDelta = 0;
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Disables the object and cancels any active suspend state.
+     */
+    void disable() {
+        this->isActive = false;
+        this->suspendTime = 0;
+        this->suspendDelta = 0;
+    }
+
+    /**
+     * @brief Suspends the object for a specified amount of time.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * clock ticks.
+     * @param[in] shouldContinue (Optional) If set to `true`, the timer will
+     * continue counting from where it left off before being suspended.
+     */
+    void suspend(TimeT suspendTime, bool shouldContinue = false) {
+        this->suspend(suspendTime, shouldContinue, now());
+    }
+
+    /**
+     * @brief Suspends the object using the given current time.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * clock ticks.
+     * @param[in] shouldContinue If set to `true`, the timer will continue
+     * counting from where it left off before being suspended.
+     * @param[in] now The current time in clock ticks.
+     */
+    void suspend(TimeT suspendTime, bool shouldContinue, TimeT now) {
+        this->suspendDelta = shouldContinue ? this->getDelta(now) : 0;
+        this->suspendTime = suspendTime;
+        this->isActive = false;
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Sets the delay interval and resets the timer.
+     *
+     * @param[in] interval The new delay time in clock ticks.
+     */
+    void setInterval(TimeT interval) {
+        this->interval = interval;
+        this->resetTime();
+    }
+
+    /**
+     * @brief Retrieves the configured delay interval.
+     *
+     * @return The configured delay time in clock ticks.
+     */
+    TimeT getInterval() {
+        return this->interval;
+    }
+
+    /**
+     * @brief Sets the callback function for the timer.
+     *
+     * @param[in] fn The callback function.
+     */
+    void setCallback(CallbackFunction fn) {
+        this->callbackFunction = fn;
+    }
+
+    /**
+     * @brief Checks if a callback function is set.
+     *
+     * @return True if a callback function is set, false otherwise.
+     */
+    bool hasCallback() {
+        return this->callbackFunction != nullptr;
+    }
+
+    /**
+     * @brief Retrieves the current callback function.
+     *
+     * @return The current callback function or nullptr.
+     */
+    CallbackFunction getCallback() {
+        return this->callbackFunction;
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback() {
+        return this->execCallback(now());
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired
+     * using the given current time.
+     *
+     * @param[in] now The current time in clock ticks.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback(TimeT now) {
+        if (this->isActive && this->hasCallback() && this->isOver(now)) {
+            this->callbackFunction();
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Resets the internal timestamp to the current time.
+     */
+    void resetTime() {
+        this->resetTime(now());
+    }
+
+    /**
+     * @brief Resets the internal timestamp to the given current time.
+     *
+     * @param[in] now The current time in clock ticks.
+     */
+    void resetTime(TimeT now) {
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Calculates the time elapsed since the last reset.
+     *
+     * @return The time difference in clock ticks.
+     */
+    TimeT getDelta() {
+        return this->getDelta(now());
+    }
+
+    /**
+     * @brief Calculates the time elapsed since the last reset using the
+     * given current time.
+     *
+     * The subtraction is done at the width of the clock counter, so it is
+     * correct across the rollover of the clock.
+     *
+     * @param[in] now The current time in clock ticks.
+     *
+     * @return The time difference in clock ticks.
+     */
+    TimeT getDelta(TimeT now) {
+        return static_cast<TimeT>((now - this->timestamp) & Clock::mask);
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isOver() {
+        return this->isOver(now());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time.
+     *
+     * Resets the timer and increments the counter when the interval has
+     * expired. Never returns `true` if the object is not active. The poll
+     * that ends a suspend returns `false`.
+     *
+     * @param[in] now The current time in clock ticks.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isOver(TimeT now) {
+        if (!this->isActive) {
+            if (this->suspendTime != 0 &&
+                this->getDelta(now) >= this->suspendTime) {
+                TimeT delta = this->suspendDelta;
+                this->enable(now);
+                this->timestamp =
+                    static_cast<TimeT>((now - delta) & Clock::mask);
+            }
+
+            return false;
+        }
+
+        if (this->getDelta(now) >= this->interval) {
+            this->count++;
+            this->timestamp = now;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired and resets the timer.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone() {
+        return this->isOver(now());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time and resets the timer.
+     *
+     * @param[in] now The current time in clock ticks.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone(TimeT now) {
+        return this->isOver(now);
+    }
+
+    /**
+     * @brief Gets the number of times the object has become active.
+     *
+     * @return The number of times the object has been active.
+     */
+    CountT getCount() {
+        return this->count;
+    }
+
+    /**
+     * @brief Resets the activation count to zero.
+     */
+    void resetCount() {
+        this->count = 0;
+    }
+
+    /**
+     * @brief Checks if the object has been active an even number of times.
+     *
+     * @retval true If the internal counter is an even number.
+     * @retval false Otherwise, including when the counter is zero.
+     */
+    bool isEven() {
+        return this->count % 2 == 0 && this->count != 0;
+    }
+
+    /**
+     * @brief Checks if the object has been active an odd number of times.
+     *
+     * @retval true If the internal counter is an odd number.
+     * @retval false Otherwise, including when the counter is zero.
+     */
+    bool isOdd() {
+        return this->count % 2 != 0 && this->count != 0;
+    }
+
+    /**
+     * @brief Checks if the object has never been active.
+     *
+     * @retval true If the internal counter is zero.
+     * @retval false otherwise.
+     */
+    bool isNever() {
+        return this->count == 0;
+    }
+};
+
+/**
+ * @brief A Delay with 16-bit timestamps and an 8-bit counter, for intervals
+ * up to 65.5 seconds.
+ */
+typedef BasicDelay<uint16_t, uint8_t> ShortDelay;
+
+/**
+ * @brief A Delay with 64-bit timestamps that never wrap.
+ */
+typedef BasicDelay<uint64_t, uint32_t> LongDelay;
+
+/**
+ * @brief A Delay with microsecond resolution backed by micros().
+ */
+typedef BasicDelay<unsigned long, unsigned long,
+                   DelayMicrosClock<unsigned long>>
+    MicroDelay;
+
+#endif  // _BASIC_DELAY_H
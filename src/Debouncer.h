@@ -0,0 +1,233 @@
+/**
+ * @brief Provides an interrupt-fed debouncer packed into a single word.
+ *
+ */
+#ifndef _DEBOUNCER_H
+#define _DEBOUNCER_H
+
+#include "Delay.h"
+
+#if defined(ARDUINO_ARCH_RP2040)
+#include <hardware/sync.h>
+#endif
+
+/**
+ * @brief Defines the stable edges reported by Debouncer::update().
+ */
+enum class DebounceEdge : uint8_t {
+    None,
+    Rising,
+    Falling
+};
+
+/**
+ * @brief This class filters the bounces of a switch fed from a pin-change
+ * interrupt.
+ * @class Debouncer
+ *
+ * The whole state is one 32-bit word: the last raw level, the stable level
+ * and a 30-bit timestamp of the last raw change. The interrupt only stores
+ * a new level and the time, and update() reports the edge once the level
+ * has held for the debounce time. An idle input, whose raw level equals
+ * the stable one, costs a single load in update() and no millis() call, so
+ * many pins can be debounced without a Delay object each and without
+ * polling digitalRead().
+ *
+ * The 30-bit timestamp wraps every 12.4 days, the differences are taken
+ * in the same width, so the wrap is handled like the millis() rollover.
+ * feed() and update() must run on the same core: update() only masks the
+ * interrupts of its own core, so on the dual-core ESP32 it does not
+ * protect against an ISR on the other one.
+ *
+ * @code
+ * Debouncer<20> button(HIGH);
+ *
+ * void onButtonChange() {
+ *   button.feed(digitalRead(BUTTON_PIN));
+ * }
+ *
+ * void setup() {
+ *   pinMode(BUTTON_PIN, INPUT_PULLUP);
+ *   attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButtonChange,
+ *                   CHANGE);
+ * }
+ *
+ * void loop() {
+ *   if (button.update() == DebounceEdge::Falling) {
+ *     // The button was pressed.
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam Time The debounce time in milliseconds.
+ */
+template <unsigned long Time = 20>
+class Debouncer {
+private:
+    static_assert(Time < (1UL << 29), "Debouncer time is too long");
+
+    /**
+     * @brief The bit of the last raw level.
+     */
+    static constexpr uint32_t RawBit = (uint32_t)1 << 31;
+
+    /**
+     * @brief The bit of the stable level.
+     */
+    static constexpr uint32_t StableBit = (uint32_t)1 << 30;
+
+    /**
+     * @brief The bits of the timestamp.
+     */
+    static constexpr uint32_t TimeMask = StableBit - 1;
+
+    /**
+     * @brief The raw level, the stable level and the time (in
+     * milliseconds, modulo 2^30) of the last raw change.
+     */
+    volatile uint32_t state;
+
+    /**
+     * @brief Masks the interrupts of the current core, safe to nest and to
+     * use in an ISR.
+     *
+     * @return The saved interrupt state.
+     */
+    static uint32_t lock() {
+#if defined(__AVR__)
+        uint8_t state = SREG;
+        cli();
+        return state;
+#elif defined(ESP32)
+        return portSET_INTERRUPT_MASK_FROM_ISR();
+#elif defined(ARDUINO_ARCH_RP2040)
+        return save_and_disable_interrupts();
+#else
+        // No portable way to read the state, interrupts are assumed on.
+        noInterrupts();
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Restores the interrupt state saved by lock().
+     *
+     * @param[in] state The saved interrupt state.
+     */
+    static void unlock(uint32_t state) {
+#if defined(__AVR__)
+        SREG = (uint8_t)state;
+#elif defined(ESP32)
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+#elif defined(ARDUINO_ARCH_RP2040)
+        restore_interrupts(state);
+#else
+        (void)state;
+        interrupts();
+#endif
+    }
+
+public:
+    /**
+     * @brief Constructs a new Debouncer object.
+     *
+     * @param[in] level The initial level of the input.
+     */
+    explicit Debouncer(bool level = false)
+        : state(level ? RawBit | StableBit : 0) {}
+
+    /**
+     * @brief Records the level of the input, usually from its pin-change
+     * interrupt.
+     *
+     * @param[in] level The level read from the input.
+     */
+    void feed(bool level) {
+        this->feed(level, millis());
+    }
+
+    /**
+     * @brief Records the level of the input using the given current time.
+     *
+     * The debounce time restarts only when the level differs from the last
+     * one, so repeated interrupts with the same level are harmless.
+     *
+     * @param[in] level The level read from the input.
+     * @param[in] now The current time in milliseconds.
+     */
+    void feed(bool level, unsigned long now) {
+        uint32_t current = this->state;
+        if (((current & RawBit) != 0) == level) {
+            return;
+        }
+
+        this->state =
+            (current & StableBit) | (level ? RawBit : 0) | (now & TimeMask);
+    }
+
+    /**
+     * @brief Reports the stable edge, if any.
+     *
+     * @return The edge of the stable level since the last call.
+     */
+    DebounceEdge update() {
+        if (!this->isPending()) {
+            return DebounceEdge::None;
+        }
+
+        return this->update(millis());
+    }
+
+    /**
+     * @brief Reports the stable edge, if any, using the given current time.
+     *
+     * The edge is reported once, when the raw level has held for the
+     * debounce time. The interrupts of the current core are masked for the
+     * read and the write of the state and restored afterwards, so it may
+     * also be called with the interrupts already disabled.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The edge of the stable level since the last call.
+     */
+    DebounceEdge update(unsigned long now) {
+        DebounceEdge edge = DebounceEdge::None;
+
+        // The interrupt must not change the word between the read and the
+        // write, which are not atomic on 8-bit MCUs.
+        uint32_t saved = lock();
+        uint32_t current = this->state;
+        bool raw = (current & RawBit) != 0;
+        if (raw != ((current & StableBit) != 0) &&
+            ((now - current) & TimeMask) >= Time) {
+            this->state = current ^ StableBit;
+            edge = raw ? DebounceEdge::Rising : DebounceEdge::Falling;
+        }
+        unlock(saved);
+
+        return edge;
+    }
+
+    /**
+     * @brief Gets the stable level, updated first.
+     *
+     * @return The stable level.
+     */
+    bool read() {
+        this->update();
+        return (this->state & StableBit) != 0;
+    }
+
+    /**
+     * @brief Checks if the raw level differs from the stable level.
+     *
+     * @retval true If an edge is being debounced.
+     * @retval false If the input is idle.
+     */
+    bool isPending() {
+        uint32_t current = this->state;
+        return ((current & RawBit) != 0) != ((current & StableBit) != 0);
+    }
+};
+
+#endif  // _DEBOUNCER_H
@@ -1,4 +1,6 @@
 #include "Delay.h"
+#include "DelayPolicy.h"
+#include "DelayScheduler.h"
 
 /**
  * @brief Constructs a new Delay object and sets its interval.
@@ -9,10 +11,29 @@
  * @param[in] interval The delay time in milliseconds. Defaults to 0.
  * @param[in] isActive Indicates whether the timer is active.
  */
-Delay::Delay(unsigned long interval = 0, bool isActive = true)
+Delay::Delay(unsigned long interval, bool isActive)
     : interval(interval),
-      isActive(isActive),
-      timestamp(millis()) {
+      timestamp(millis()),
+      isActive(isActive) {
+}
+
+bool (*Delay::hardwareTimerRemove)(Delay& delay) = nullptr;
+
+/**
+ * @brief Destroys the Delay object.
+ *
+ * If the object is registered in a DelayScheduler or served by the
+ * DelayHardwareTimer, it is removed from there, so neither keeps a
+ * dangling pointer.
+ */
+Delay::~Delay() {
+    if (this->link.scheduler != nullptr) {
+        this->link.scheduler->remove(*this);
+    }
+
+    if (hardwareTimerRemove != nullptr) {
+        hardwareTimerRemove(*this);
+    }
 }
 
 /**
@@ -28,10 +49,83 @@ Delay::Delay(unsigned long interval = 0, bool isActive = true)
  * become active.
  */
 void Delay::enable() {
+    this->enable(millis());
+}
+
+/**
+ * @brief Enables the Delay object using the given current time.
+ *
+ * Same as enable(), but the timer is reset to the `now` timestamp instead
+ * of reading the system clock.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::enable(unsigned long now) {
     this->isActive = true;
     this->suspendTime = 0;
     this->suspendDelta = 0;
-    this->resetTime();
+    this->resetTime(now);
+}
+
+/**
+ * @brief Arms the Delay object again from the current time.
+ *
+ * In the `DelayMode::OneShot` mode the object disables itself after it has
+ * triggered, and restart() arms it for one more interval. It is also the
+ * way to push a pending timeout back, for example on every received
+ * message.
+ *
+ * @code
+ * Delay responseTimeout(500);
+ * responseTimeout.setMode(DelayMode::OneShot);
+ *
+ * void onRequestSent() {
+ *   responseTimeout.restart();
+ * }
+ *
+ * void onResponse() {
+ *   responseTimeout.cancel();
+ * }
+ * @endcode
+ */
+void Delay::restart() {
+    this->enable(millis());
+}
+
+/**
+ * @brief Arms the Delay object again from the given current time.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::restart(unsigned long now) {
+    this->enable(now);
+}
+
+/**
+ * @brief Cancels a pending trigger of the Delay object.
+ *
+ * The object is disabled and does not read the clock. It triggers again
+ * only after restart() or enable().
+ */
+void Delay::cancel() {
+    this->disable();
+}
+
+/**
+ * @brief Ends the suspend state of the Delay object.
+ *
+ * The timestamp is moved back by the time that had elapsed in the interval
+ * before the suspend (zero unless suspended with continuation), so the
+ * interval continues from where it left off.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void Delay::resume(unsigned long now) {
+    this->isActive = true;
+    this->suspendTime = 0;
+    this->timestamp = now - this->suspendDelta;
+    this->suspendDelta = 0;
+    this->reschedule(now);
 }
 
 /**
@@ -48,6 +142,9 @@ void Delay::disable() {
     this->isActive = false;
     this->suspendTime = 0;
     this->suspendDelta = 0;
+
+    // A disabled object has no deadline, so the time is not needed.
+    this->reschedule(0);
 }
 
 /**
@@ -70,15 +167,72 @@ void Delay::disable() {
  * effectively losing any time that has already elapsed towards the next
  * interval.
  */
-void Delay::suspend(unsigned long suspendTime, bool shouldContinue = false) {
+void Delay::suspend(unsigned long suspendTime, bool shouldContinue) {
+    this->suspend(suspendTime, shouldContinue, millis());
+}
+
+/**
+ * @brief Suspends the Delay object using the given current time.
+ *
+ * Same as suspend(), but the elapsed time and the start of the suspend
+ * are taken from `now` instead of the system clock.
+ *
+ * @param[in] suspendTime The amount of time to suspend the Delay object,
+ * in milliseconds.
+ * @param[in] shouldContinue If set to `true`, the timer will continue
+ * counting from where it left off before being suspended.
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::suspend(unsigned long suspendTime, bool shouldContinue,
+                    unsigned long now) {
     // Save the time that the timer has already passed before calling the
     // suspend method.
-    this->suspendDelta = shouldContinue ? this->getDelta() : 0;
+    this->suspendDelta = shouldContinue ? this->getDelta(now) : 0;
 
     // Set the suspend time and disable the timer.
     this->suspendTime = suspendTime;
     this->isActive = false;
-    this->resetTime();
+    this->resetTime(now);
+}
+
+/**
+ * @brief Moves the next deadline of the Delay object later.
+ *
+ * @param[in] offset The time to move the deadline by, in milliseconds.
+ */
+void Delay::shift(unsigned long offset) {
+    this->shift(offset, millis());
+}
+
+/**
+ * @brief Moves the next deadline of the Delay object later using the given
+ * current time.
+ *
+ * The timestamp can only be moved forward up to `now`, because a timestamp
+ * in the future would read as an expired interval. For a longer offset the
+ * object is suspended until the moved timestamp and then continues from
+ * the start of the interval, so the deadline is the same.
+ *
+ * @param[in] offset The time to move the deadline by, in milliseconds.
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::shift(unsigned long offset, unsigned long now) {
+    if (!this->isActive) {
+        if (this->suspendTime != 0) {
+            this->suspendTime += offset;
+            this->reschedule(now);
+        }
+
+        return;
+    }
+
+    unsigned long delta = this->getDelta(now);
+    if (offset <= delta) {
+        this->timestamp += offset;
+        this->reschedule(now);
+    } else {
+        this->suspend(offset - delta, false, now);
+    }
 }
 
 /**
@@ -91,16 +245,26 @@ void Delay::suspend(unsigned long suspendTime, bool shouldContinue = false) {
  * @param[in] interval The new delay time in milliseconds.
  */
 void Delay::setInterval(unsigned long interval) {
+    this->setInterval(interval, millis());
+}
+
+/**
+ * @brief Sets the delay interval for the Delay object and restarts the
+ * timer at the given current time.
+ *
+ * @param[in] interval The new delay time in milliseconds.
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::setInterval(unsigned long interval, unsigned long now) {
     // Zero is a valid value - the delay never happens (is always ready).
     // A negative number cannot be set, because the unsigned long type is used.
     // The value cannot be greater than DELAY_MAX_INTERVAL,
     if (interval > ULONG_MAX - 1) {
         interval = ULONG_MAX - 1;
-    } else {
-        this->interval = interval;
     }
 
-    this->resetTime();
+    this->interval = interval;
+    this->resetTime(now);
 }
 
 /**
@@ -115,6 +279,245 @@ unsigned long Delay::getInterval() {
     return this->interval;
 }
 
+/**
+ * @brief Sets the scheduling mode of the Delay object.
+ *
+ * In the `DelayMode::Reset` mode (default) the timer restarts from the
+ * current time each time it is triggered. In the `DelayMode::Periodic`
+ * mode the timer moves its timestamp forward by exactly one interval, so
+ * the delay of the poll does not accumulate and the timer keeps a stable
+ * rate.
+ *
+ * @code
+ * Delay sampleDelay(1);
+ * sampleDelay.setMode(DelayMode::Periodic, DelayCatchUp::Coalesce);
+ * if (sampleDelay.isOver()) {
+ *   // Runs at 1 kHz on average, getMissed() reports the dropped samples.
+ * }
+ * @endcode
+ *
+ * @param[in] mode The scheduling mode.
+ * @param[in] catchUp (Optional) The policy for missed periods in the
+ * `DelayMode::Periodic` mode. Defaults to `DelayCatchUp::Skip`.
+ */
+void Delay::setMode(DelayMode mode, DelayCatchUp catchUp) {
+    this->mode = mode;
+    this->catchUp = catchUp;
+    this->missed = 0;
+}
+
+/**
+ * @brief Returns the scheduling mode of the Delay object.
+ *
+ * @return The scheduling mode.
+ */
+DelayMode Delay::getMode() {
+    return this->mode;
+}
+
+/**
+ * @brief Returns the policy for missed periods.
+ *
+ * @return The policy for missed periods.
+ */
+DelayCatchUp Delay::getCatchUp() {
+    return this->catchUp;
+}
+
+/**
+ * @brief Returns the number of periods missed before the last trigger.
+ *
+ * The value is updated each time a periodic object is triggered. It is
+ * zero when the object was polled within one interval of its deadline.
+ *
+ * @return The number of missed periods.
+ */
+unsigned long Delay::getMissed() {
+    return this->missed;
+}
+
+/**
+ * @brief Sets the tolerance of the deadline.
+ *
+ * Like the timer slack of Linux: the deadline is not moved, but a
+ * scheduler that sleeps may wake up later, within the slack, to serve
+ * several timers at once. Polling the object directly still triggers it
+ * on time.
+ *
+ * @code
+ * Delay telemetryDelay(10000);
+ * Delay sensorDelay(9800);
+ * telemetryDelay.setSlack(500);
+ * sensorDelay.setSlack(500);
+ * // Both are served by a single wakeup at about 10000 ms.
+ * @endcode
+ *
+ * @param[in] slack The tolerance in milliseconds.
+ */
+void Delay::setSlack(uint16_t slack) {
+    this->slack = slack;
+}
+
+/**
+ * @brief Returns the tolerance of the deadline.
+ *
+ * @return The tolerance in milliseconds.
+ */
+uint16_t Delay::getSlack() {
+    return this->slack;
+}
+
+/**
+ * @brief Sets the priority class of the object in a DelayScheduler.
+ *
+ * A registered object is moved to the list of its new class.
+ *
+ * @code
+ * Delay controlDelay(1);
+ * Delay telemetryDelay(10000);
+ * controlDelay.setPriority(DelayPriority::High);
+ * telemetryDelay.setPriority(DelayPriority::Low);
+ * scheduler.setBudget(500);
+ * @endcode
+ *
+ * @param[in] priority The priority class.
+ */
+void Delay::setPriority(DelayPriority priority) {
+    DelayScheduler* scheduler = this->link.scheduler;
+    if (scheduler != nullptr) {
+        scheduler->unlink(*this);
+    }
+
+    this->priority = priority;
+    if (scheduler != nullptr) {
+        scheduler->insert(*this, millis());
+    }
+}
+
+/**
+ * @brief Returns the priority class of the object.
+ *
+ * @return The priority class.
+ */
+DelayPriority Delay::getPriority() {
+    return this->priority;
+}
+
+/**
+ * @brief Sets the policy that adjusts the interval on each trigger.
+ *
+ * The policy is asked for the next interval each time the object
+ * triggers. The new interval counts from the current deadline, so unlike
+ * setInterval() the timer is not reset.
+ *
+ * @code
+ * DelayBackoffPolicy backoff(100, 10000);
+ * retryDelay.setPolicy(&backoff);
+ * @endcode
+ *
+ * @param[in] policy The policy, nullptr for a fixed interval.
+ */
+void Delay::setPolicy(DelayPolicy* policy) {
+    this->policy = policy;
+}
+
+/**
+ * @brief Returns the interval policy.
+ *
+ * @return The policy, nullptr for a fixed interval.
+ */
+DelayPolicy* Delay::getPolicy() {
+    return this->policy;
+}
+
+#if DELAY_ENABLE_PROFILER
+/**
+ * @brief Sets the tag that names the Delay object in the DelayProfiler.
+ *
+ * @param[in] tag The tag, for example an index or an ID.
+ */
+void Delay::setTag(uint16_t tag) {
+    this->tag = tag;
+}
+
+/**
+ * @brief Returns the tag of the Delay object.
+ *
+ * @return The tag, zero if not set.
+ */
+uint16_t Delay::getTag() {
+    return this->tag;
+}
+#endif
+
+#if DELAY_ENABLE_STATS
+/**
+ * @brief Returns the timing statistics of the Delay object.
+ *
+ * @code
+ * const DelayStats& stats = led1Delay.getStats();
+ * Serial.print(stats.getMeanLateness());
+ * Serial.print(" ms late on average, worst ");
+ * Serial.println(stats.maxLateness);
+ * @endcode
+ *
+ * @return The timing statistics.
+ */
+const DelayStats& Delay::getStats() {
+    return this->stats;
+}
+
+/**
+ * @brief Clears the timing statistics of the Delay object.
+ */
+void Delay::resetStats() {
+    this->stats = DelayStats();
+}
+
+/**
+ * @brief Records the lateness of a trigger.
+ *
+ * @param[in] lateness The time between the deadline and the poll, in
+ * milliseconds.
+ */
+void Delay::recordLateness(unsigned long lateness) {
+    this->stats.triggers++;
+    this->stats.totalLateness += lateness;
+    if (lateness < this->stats.minLateness) {
+        this->stats.minLateness = lateness;
+    }
+
+    if (lateness > this->stats.maxLateness) {
+        this->stats.maxLateness = lateness;
+    }
+}
+
+/**
+ * @brief Records the execution time of a callback in the histogram.
+ *
+ * The buckets grow by a factor of four, so eight buckets cover the range
+ * from a few microseconds to 16 milliseconds.
+ *
+ * @param[in] time The execution time in microseconds.
+ */
+void Delay::recordCallbackTime(unsigned long time) {
+    if (time > this->stats.maxCallbackTime) {
+        this->stats.maxCallbackTime = time;
+    }
+
+    uint8_t bucket = 0;
+    unsigned long limit = 4;
+    while (time >= limit && bucket < DELAY_STATS_BUCKETS - 1) {
+        limit <<= 2;
+        bucket++;
+    }
+
+    if (this->stats.callbackHistogram[bucket] != UINT16_MAX) {
+        this->stats.callbackHistogram[bucket]++;
+    }
+}
+#endif
+
 /**
  * @brief Sets the callback function to be executed when the delay
  * interval is reached.
@@ -126,6 +529,39 @@ unsigned long Delay::getInterval() {
  */
 void Delay::setCallback(CallbackFunction fn) {
     this->callbackFunction = fn;
+    this->contextCallbackFunction = nullptr;
+    this->callbackContext = nullptr;
+}
+
+/**
+ * @brief Sets the callback function with a user context to be executed when
+ * the delay interval is reached.
+ *
+ * The `context` pointer is passed to the function on each call. This allows
+ * a single handler to serve many timers, each with its own state.
+ *
+ * @code
+ * struct Led {
+ *   uint8_t pin;
+ *   Delay delay;
+ * };
+ *
+ * void toggleLed(void* context) {
+ *   Led* led = static_cast<Led*>(context);
+ *   digitalWrite(led->pin, !digitalRead(led->pin));
+ * }
+ *
+ * led1.delay.setCallback(toggleLed, &led1);
+ * led2.delay.setCallback(toggleLed, &led2);
+ * @endcode
+ *
+ * @param[in] fn The function to be called as a callback.
+ * @param[in] context The user context, passed to `fn` as is.
+ */
+void Delay::setCallback(ContextCallbackFunction fn, void* context) {
+    this->callbackFunction = nullptr;
+    this->contextCallbackFunction = fn;
+    this->callbackContext = fn != nullptr ? context : nullptr;
 }
 
 /**
@@ -137,7 +573,8 @@ void Delay::setCallback(CallbackFunction fn) {
  * @return `true` if a callback function exists, `false` otherwise.
  */
 bool Delay::hasCallback() {
-    return this->callbackFunction != nullptr;
+    return this->callbackFunction != nullptr ||
+           this->contextCallbackFunction != nullptr;
 }
 
 /**
@@ -150,7 +587,39 @@ bool Delay::hasCallback() {
  * has been set.
  */
 CallbackFunction Delay::getCallback() {
-    return this->hasCallback() ? this->callbackFunction : nullptr;
+    return this->callbackFunction;
+}
+
+/**
+ * @brief Retrieves the user context of the current callback function.
+ *
+ * @return The user context, or nullptr if no callback function with a user
+ * context has been set.
+ */
+void* Delay::getCallbackContext() {
+    return this->callbackContext;
+}
+
+/**
+ * @brief Invokes the callback function that is set, if any.
+ *
+ * The timer state is not checked. Use it with isOver() to detect the
+ * expiry and to execute the callback in different contexts.
+ */
+void Delay::invokeCallback() {
+#if DELAY_ENABLE_STATS
+    unsigned long start = micros();
+#endif
+
+    if (this->callbackFunction != nullptr) {
+        this->callbackFunction();
+    } else if (this->contextCallbackFunction != nullptr) {
+        this->contextCallbackFunction(this->callbackContext);
+    }
+
+#if DELAY_ENABLE_STATS
+    this->recordCallbackTime(micros() - start);
+#endif
 }
 
 /**
@@ -162,9 +631,32 @@ CallbackFunction Delay::getCallback() {
  * @return `true` if the callback function was executed, `false` otherwise.
  */
 bool Delay::execCallback() {
+    return this->execCallback(millis());
+}
+
+/**
+ * @brief Executes the callback function using the given current time.
+ *
+ * Same as execCallback(), but the timer is checked against the `now`
+ * timestamp instead of reading the system clock. This allows many timers
+ * to share a single clock read per loop iteration.
+ *
+ * @code
+ * void loop() {
+ *   unsigned long now = millis();
+ *   led1Delay.execCallback(now);
+ *   led2Delay.execCallback(now);
+ * }
+ * @endcode
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return `true` if the callback function was executed, `false` otherwise.
+ */
+bool Delay::execCallback(unsigned long now) {
     bool result = false;
-    if (this->isActive && this->hasCallback() && this->isOver()) {
-        this->callbackFunction();
+    if (this->isActive && this->hasCallback() && this->isOver(now)) {
+        this->invokeCallback();
         result = true;
     }
 
@@ -178,7 +670,96 @@ bool Delay::execCallback() {
  * effectively resetting the timer.
  */
 void Delay::resetTime() {
-    this->timestamp = millis();
+    this->resetTime(millis());
+}
+
+/**
+ * @brief Resets the internal timestamp to the given current time.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void Delay::resetTime(unsigned long now) {
+    this->timestamp = now;
+    this->reschedule(now);
+}
+
+/**
+ * @brief Calculates the time left until the next state change.
+ *
+ * The state of the object changes when the interval expires or, for a
+ * suspended object, when the suspend time is over. The scheduler uses this
+ * value to keep its list ordered by deadline.
+ *
+ * @param[in] now The current time in milliseconds.
+ *
+ * @return The time left in milliseconds, zero if the change is due, or
+ * `ULONG_MAX` if the object is disabled.
+ */
+unsigned long Delay::timeToNext(unsigned long now) {
+    unsigned long target;
+    if (this->isActive) {
+        target = this->interval;
+    } else if (this->suspendTime != 0) {
+        target = this->suspendTime;
+    } else {
+        return ULONG_MAX;
+    }
+
+    unsigned long delta = this->getDelta(now);
+    return delta >= target ? 0 : target - delta;
+}
+
+/**
+ * @brief Notifies the scheduler that the deadline has changed.
+ *
+ * Does nothing if the object is not registered in a scheduler.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void Delay::reschedule(unsigned long now) {
+    if (this->link.scheduler != nullptr) {
+        this->link.scheduler->reschedule(*this, now);
+    }
+}
+
+/**
+ * @brief Moves the timestamp to the next deadline of a periodic object.
+ *
+ * The timestamp is moved forward by whole intervals, so the phase of the
+ * timer is kept regardless of how late the object was polled. The number
+ * of missed periods is handled according to the catch-up policy.
+ *
+ * @param[in] delta The time elapsed since the timestamp, in milliseconds.
+ */
+void Delay::advance(unsigned long delta) {
+    // A zero interval has no phase to keep.
+    if (this->interval == 0) {
+        this->missed = 0;
+        this->timestamp += delta;
+        return;
+    }
+
+    // Avoid the division in the common case when the object is polled
+    // within one interval of its deadline.
+    unsigned long periods = delta - this->interval < this->interval
+                                ? 1
+                                : delta / this->interval;
+    this->missed = periods - 1;
+
+    switch (this->catchUp) {
+    case DelayCatchUp::Burst:
+        // The remaining periods trigger on the next polls.
+        this->timestamp += this->interval;
+        break;
+    case DelayCatchUp::Coalesce:
+        this->count += this->missed;
+        this->timestamp += periods * this->interval;
+        break;
+    case DelayCatchUp::Skip:
+    default:
+        this->timestamp += periods * this->interval;
+        break;
+    }
 }
 
 /**
@@ -193,16 +774,91 @@ void Delay::resetTime() {
  * @return The elapsed time in milliseconds.
  */
 unsigned long Delay::getDelta() {
-    // The millis method resets to zero when the ULONG_MAX range is reached.
-    // Therefore, if the last fixation of time was close to the moment of
-    // resetting the delta can get a value with a very large range
-    // close to ULONG_MAX.
-    //
-    // We can determine the overflow of millis (approximately every 50 days) -
-    // if millis is less than the timestamp.
-    unsigned long m = millis();
-    return m < this->timestamp ? ULONG_MAX - this->timestamp + m
-                               : m - this->timestamp;
+    return this->getDelta(millis());
+}
+
+/**
+ * @brief Calculates the elapsed time since the last timestamp update using
+ * the given current time.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The elapsed time in milliseconds.
+ */
+unsigned long Delay::getDelta(unsigned long now) {
+    // The millis method resets to zero when the 32-bit range is reached.
+    // The subtraction is taken modulo 2^32, so the difference is correct
+    // across the rollover without a branch, as long as less than one full
+    // range (approximately 50 days) has elapsed.
+    return delayElapsed(now, this->timestamp);
+}
+
+/**
+ * @brief Calculates the time left until the Delay object triggers.
+ *
+ * @return The time left in milliseconds, zero if the object is due, or
+ * `ULONG_MAX` if it is disabled.
+ */
+unsigned long Delay::remainingTime() {
+    return this->remainingTime(millis());
+}
+
+/**
+ * @brief Calculates the time left until the Delay object triggers using the
+ * given current time.
+ *
+ * For a suspended object the result is the rest of the suspend time plus
+ * the part of the interval that is left after it.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The time left in milliseconds, zero if the object is due, or
+ * `ULONG_MAX` if it is disabled.
+ */
+unsigned long Delay::remainingTime(unsigned long now) {
+    unsigned long delta = this->getDelta(now);
+    if (this->isActive) {
+        return delta >= this->interval ? 0 : this->interval - delta;
+    }
+
+    if (this->suspendTime == 0) {
+        return ULONG_MAX;
+    }
+
+    unsigned long left = delta >= this->suspendTime
+                             ? 0
+                             : this->suspendTime - delta;
+    if (this->suspendDelta < this->interval) {
+        left += this->interval - this->suspendDelta;
+    }
+
+    return left;
+}
+
+/**
+ * @brief Calculates how long a task may block before the next poll.
+ *
+ * @return The time left in milliseconds, zero if a poll is due, or
+ * `ULONG_MAX` if the object is disabled.
+ */
+unsigned long Delay::timeUntilUpdate() {
+    return this->timeToNext(millis());
+}
+
+/**
+ * @brief Calculates how long a task may block before the next poll using
+ * the given current time.
+ *
+ * A suspended object returns the end of the suspend, as it resumes when
+ * it is polled.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The time left in milliseconds, zero if a poll is due, or
+ * `ULONG_MAX` if the object is disabled.
+ */
+unsigned long Delay::timeUntilUpdate(unsigned long now) {
+    return this->timeToNext(now);
 }
 
 /**
@@ -236,28 +892,83 @@ unsigned long Delay::getDelta() {
  * `false` otherwise.
  */
 bool Delay::isOver() {
-    if (!this->isActive && this->suspendTime == 0) {
-        // If disabled and suspend time is 0, then the object is never done.
-        return false;
-    } else if (!this->isActive && this->suspendTime != 0) {
-        // If disabled and suspend time is not 0, then the object is done
-        // when the suspend time has elapsed.
-        if (this->getDelta() >= this->suspendTime) {
-            this->enable();
-        }
+    return this->isOver(millis());
+}
 
-        // Returns false because only the suspend time ended.
-        return false;
-    }
+/**
+ * @brief Checks if the delay interval has been reached or exceeded using the
+ * given current time.
+ *
+ * Same as isOver(), but the timer is checked against the `now` timestamp
+ * and the system clock is never read. Use it to poll many timers with a
+ * single millis() call per loop iteration.
+ *
+ * @code
+ * void loop() {
+ *   unsigned long now = millis();
+ *   if (led1Delay.isOver(now)) {
+ *     // ...
+ *   }
+ *
+ *   if (led2Delay.isOver(now)) {
+ *     // ...
+ *   }
+ * }
+ * @endcode
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return `true` if the delay interval is reached or exceeded,
+ * `false` otherwise.
+ */
+bool Delay::isOver(unsigned long now) {
+    if (this->isActive) {
+        // Fast path: an active object that is not due yet costs a single
+        // subtract-and-compare. The time elapsed before a suspend is
+        // already folded into the timestamp by resume().
+        unsigned long delta = delayElapsed(now, this->timestamp);
+        if (delta < this->interval) {
+            return false;
+        }
 
-    // If the object is active, then the count is incremented.
-    if (this->getDelta() >= (this->interval - this->suspendDelta)) {
+        // If the object is active, then the count is incremented.
+        unsigned long lateness = delta - this->interval;
         this->count++;
-        this->suspendDelta = 0;
-        this->resetTime();
+#if DELAY_ENABLE_STATS
+        this->recordLateness(lateness);
+#endif
+        if (this->mode == DelayMode::Periodic) {
+            this->advance(delta);
+#if DELAY_ENABLE_STATS
+            this->stats.missed += this->missed;
+#endif
+        } else if (this->mode == DelayMode::OneShot) {
+            // The timestamp is kept, so getDelta() tells how late the
+            // object was polled.
+            this->isActive = false;
+        } else {
+            this->timestamp = now;
+        }
+
+        if (this->policy != nullptr) {
+            // The next period starts at the timestamp set above, with the
+            // interval chosen by the policy.
+            this->interval = this->policy->nextInterval(this->interval,
+                                                        lateness);
+        }
+
+        this->reschedule(now);
         return true;
     }
 
+    // If disabled and suspend time is not 0, then the object becomes
+    // active again when the suspend time has elapsed. If disabled and
+    // suspend time is 0, then the object is never done.
+    if (this->suspendTime != 0 && this->getDelta(now) >= this->suspendTime) {
+        this->resume(now);
+    }
+
+    // Returns false because only the suspend time ended.
     return false;
 }
 
@@ -288,16 +999,33 @@ bool Delay::isOver() {
  *
  * @note Never returns true if the `isActive` is `false`.
  *
+ * @note In the `DelayMode::Periodic` mode the timer is not reset, so the
+ * phase of the timer is kept.
+ *
  * @return `true` if the delay interval is reached or exceeded,
  * `false` otherwise.
  */
 bool Delay::isDone() {
-    bool result = this->isOver();
-    if (result) {
-        this->resetTime();
-    }
+    return this->isDone(millis());
+}
 
-    return result;
+/**
+ * @brief Checks if the delay interval has been reached or exceeded using the
+ * given current time, and resets the timer.
+ *
+ * Same as isDone(), but the timer is checked against the `now` timestamp
+ * and the system clock is never read.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return `true` if the delay interval is reached or exceeded,
+ * `false` otherwise.
+ */
+bool Delay::isDone(unsigned long now) {
+    // The isOver method has already reset the timer to the `now`
+    // timestamp (or advanced it in the periodic mode), so there is no
+    // need to read the clock and reset it again.
+    return this->isOver(now);
 }
 
 /**
@@ -363,3 +1091,140 @@ bool Delay::isOdd() {
 bool Delay::isNever() {
     return this->count == 0;
 }
+
+/**
+ * @brief Calculates the Fletcher-16 checksum of a snapshot.
+ *
+ * The checksum field itself is skipped.
+ *
+ * @param[in] snapshot The snapshot.
+ *
+ * @return The checksum.
+ */
+static uint16_t delaySnapshotChecksum(const DelaySnapshot& snapshot) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&snapshot);
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+    for (size_t i = 0; i < sizeof(DelaySnapshot); i++) {
+        if (i == offsetof(DelaySnapshot, checksum)) {
+            i += sizeof(snapshot.checksum) - 1;
+            continue;
+        }
+
+        sum1 = (sum1 + bytes[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+
+    return (sum2 << 8) | sum1;
+}
+
+/**
+ * @brief Saves the state of the Delay object into a fixed-layout record.
+ *
+ * The callback, the policy, the slack and the scheduler registration are
+ * not saved: they are code and wiring, set up again in setup().
+ *
+ * @code
+ * RTC_DATA_ATTR DelaySnapshot reportSnapshot;
+ *
+ * void goToSleep() {
+ *   reportSnapshot = reportDelay.serialize();
+ *   esp_deep_sleep(sleepTime);
+ * }
+ * @endcode
+ *
+ * @return The snapshot of the state.
+ */
+DelaySnapshot Delay::serialize() {
+    return this->serialize(millis());
+}
+
+/**
+ * @brief Saves the state of the Delay object using the given current time.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The snapshot of the state.
+ */
+DelaySnapshot Delay::serialize(unsigned long now) {
+    DelaySnapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+
+    snapshot.version = DelaySnapshot::Version;
+    snapshot.flags = (this->isActive ? 0x01 : 0) |
+                     (this->suspendTime != 0 ? 0x02 : 0) |
+                     ((uint8_t)this->mode << 2) |
+                     ((uint8_t)this->catchUp << 4);
+    snapshot.interval = this->interval;
+    snapshot.elapsed = this->getDelta(now);
+    snapshot.count = this->count;
+    snapshot.suspendTime = this->suspendTime;
+    snapshot.suspendDelta = this->suspendDelta;
+    snapshot.checksum = delaySnapshotChecksum(snapshot);
+    return snapshot;
+}
+
+/**
+ * @brief Restores the state of the Delay object from a snapshot.
+ *
+ * @param[in] snapshot The snapshot made by serialize().
+ * @param[in] slept The time in milliseconds that has passed between the
+ * snapshot and the start of millis().
+ *
+ * @return `true` if the snapshot was restored, `false` if it is invalid.
+ */
+bool Delay::restore(const DelaySnapshot& snapshot, unsigned long slept) {
+    return this->restore(snapshot, slept, millis());
+}
+
+/**
+ * @brief Restores the state of the Delay object from a snapshot using the
+ * given current time.
+ *
+ * The timestamp is set so that the elapsed time is the one saved in the
+ * snapshot plus the sleep time plus `now`, the time since the start of
+ * millis(). A timer whose interval or suspend time has passed during the
+ * sleep is due on the next poll, so a long interval continues across the
+ * sleep cycles instead of starting over.
+ *
+ * @param[in] snapshot The snapshot made by serialize().
+ * @param[in] slept The time in milliseconds that has passed between the
+ * snapshot and the start of millis().
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return `true` if the snapshot was restored, `false` if it is invalid.
+ */
+bool Delay::restore(const DelaySnapshot& snapshot, unsigned long slept,
+                    unsigned long now) {
+    if (snapshot.version != DelaySnapshot::Version ||
+        snapshot.checksum != delaySnapshotChecksum(snapshot)) {
+        return false;
+    }
+
+    this->isActive = (snapshot.flags & 0x01) != 0;
+    this->mode = (DelayMode)((snapshot.flags >> 2) & 0x03);
+    this->catchUp = (DelayCatchUp)((snapshot.flags >> 4) & 0x03);
+    this->interval = snapshot.interval;
+    this->count = snapshot.count;
+    this->missed = 0;
+
+    if ((snapshot.flags & 0x02) != 0 && !this->isActive) {
+        this->suspendTime = snapshot.suspendTime;
+        this->suspendDelta = snapshot.suspendDelta;
+    } else {
+        this->suspendTime = 0;
+        this->suspendDelta = 0;
+    }
+
+    // millis() has started from zero after the sleep, so `now` is the
+    // time since then. The sum is capped at the range of the clock.
+    unsigned long elapsed = snapshot.elapsed;
+    unsigned long parts[] = {slept, now};
+    for (unsigned long part : parts) {
+        elapsed = elapsed > ULONG_MAX - part ? ULONG_MAX : elapsed + part;
+    }
+
+    this->timestamp = now - elapsed;
+    this->reschedule(now);
+    return true;
+}
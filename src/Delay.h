@@ -11,6 +11,38 @@
 #include <Arduino.h>
 #include <limits.h>
 
+#include "DelayConfig.h"
+
+/**
+ * @brief Computes the time elapsed between two readings of millis() or
+ * micros().
+ *
+ * The clocks wrap at 32 bits, so the difference is taken modulo 2^32,
+ * which stays correct across the rollover also where `unsigned long` is
+ * wider. On the 32-bit and 8-bit targets this is a plain subtraction.
+ *
+ * @param[in] now The later reading.
+ * @param[in] then The earlier reading.
+ *
+ * @return The elapsed time, less than 2^32.
+ */
+inline unsigned long delayElapsed(unsigned long now, unsigned long then) {
+    return (uint32_t)(now - then);
+}
+
+/**
+ * @brief Computes the signed time from a reading of millis() to a
+ * deadline in its range.
+ *
+ * @param[in] deadline The deadline.
+ * @param[in] now The current reading.
+ *
+ * @return The time left, negative once the deadline has passed.
+ */
+inline long delayUntil(unsigned long deadline, unsigned long now) {
+    return (int32_t)(uint32_t)(deadline - now);
+}
+
 /**
  * @brief Type definition for a callback function with no arguments and no
  * return value.
@@ -22,6 +54,226 @@
  */
 typedef void (*CallbackFunction)();
 
+/**
+ * @brief Type definition for a callback function with a user context.
+ *
+ * The `context` pointer given to Delay::setCallback() is passed back on each
+ * call, so a single function can serve many timers, each with its own
+ * state, without heap allocation.
+ */
+typedef void (*ContextCallbackFunction)(void* context);
+
+/**
+ * @brief Defines how the next interval is scheduled after the Delay object
+ * has been triggered.
+ *
+ * In the `Reset` mode the next interval starts at the moment the object is
+ * polled, so any lateness of the poll is added to the next interval. In the
+ * `Periodic` mode the next deadline is the previous deadline plus the
+ * interval, so the timer stays phase-locked to its start time and does
+ * not drift. In the `OneShot` mode the object triggers once and then
+ * disables itself, until it is armed again with restart().
+ */
+enum class DelayMode : uint8_t {
+    Reset,
+    Periodic,
+    OneShot
+};
+
+/**
+ * @brief Defines the priority class of a Delay object in a DelayScheduler.
+ *
+ * - `High` objects always run, whatever the budget of the pass.
+ * - `Normal` objects run while the budget of the pass lasts.
+ * - `Low` objects run after the `Normal` ones, with what is left of the
+ *   budget.
+ *
+ * Due objects that do not fit into the budget are deferred to the next
+ * pass, see DelayScheduler::setBudget().
+ */
+enum class DelayPriority : uint8_t {
+    High,
+    Normal,
+    Low
+};
+
+/**
+ * @brief Defines how a periodic Delay object handles missed periods.
+ *
+ * A period is missed when the object is polled later than one whole
+ * interval after its deadline.
+ *
+ * - `Skip` drops the missed periods and keeps the original phase.
+ * - `Burst` triggers once per poll for every missed period until the timer
+ *   has caught up.
+ * - `Coalesce` triggers once, keeps the original phase and adds the
+ *   missed periods to the counter.
+ *
+ * In all cases the number of missed periods can be read with getMissed().
+ */
+enum class DelayCatchUp : uint8_t {
+    Skip,
+    Burst,
+    Coalesce
+};
+
+/**
+ * @brief A fixed-layout record of the state of a Delay object.
+ *
+ * Made by Delay::serialize() to survive a deep sleep or a reset in RTC
+ * memory, EEPROM or flash. The fields have a fixed width and natural
+ * alignment, so the record has the same 24-byte layout on all targets.
+ * The times are stored relative to the moment of the snapshot, because
+ * millis() starts again from zero after a reset.
+ */
+struct DelaySnapshot {
+    /**
+     * @brief The layout version, `DelaySnapshot::Version`.
+     */
+    uint8_t version;
+
+    /**
+     * @brief The active and suspended bits, the mode and the catch-up
+     * policy.
+     */
+    uint8_t flags;
+
+    /**
+     * @brief The Fletcher-16 checksum of all other fields.
+     */
+    uint16_t checksum;
+
+    /**
+     * @brief The delay interval in milliseconds.
+     */
+    uint32_t interval;
+
+    /**
+     * @brief The time elapsed since the timestamp, in milliseconds.
+     */
+    uint32_t elapsed;
+
+    /**
+     * @brief The number of triggers.
+     */
+    uint32_t count;
+
+    /**
+     * @brief The suspend time in milliseconds.
+     */
+    uint32_t suspendTime;
+
+    /**
+     * @brief The time elapsed in the interval before the suspend.
+     */
+    uint32_t suspendDelta;
+
+    /**
+     * @brief The current layout version.
+     */
+    static constexpr uint8_t Version = 1;
+};
+
+#if DELAY_ENABLE_STATS
+/**
+ * @brief Timing statistics of a Delay object.
+ *
+ * The lateness is the time between the deadline and the poll that
+ * triggered the object, in milliseconds. The callback times are measured
+ * with micros() around the callbacks run by execCallback() and by the
+ * scheduler.
+ */
+struct DelayStats {
+    /**
+     * @brief The number of triggers.
+     */
+    unsigned long triggers = 0;
+
+    /**
+     * @brief The smallest lateness of a trigger.
+     */
+    unsigned long minLateness = ULONG_MAX;
+
+    /**
+     * @brief The largest lateness of a trigger.
+     */
+    unsigned long maxLateness = 0;
+
+    /**
+     * @brief The sum of the lateness of all triggers.
+     */
+    unsigned long totalLateness = 0;
+
+    /**
+     * @brief The total number of missed periods in the
+     * `DelayMode::Periodic` mode.
+     */
+    unsigned long missed = 0;
+
+    /**
+     * @brief The longest callback, in microseconds.
+     */
+    unsigned long maxCallbackTime = 0;
+
+    /**
+     * @brief The histogram of the callback times, see
+     * `DELAY_STATS_BUCKETS`. The counters stop at 65535.
+     */
+    uint16_t callbackHistogram[DELAY_STATS_BUCKETS] = {};
+
+    /**
+     * @brief Calculates the mean lateness of the triggers.
+     *
+     * @return The mean lateness in milliseconds, zero if never triggered.
+     */
+    unsigned long getMeanLateness() const {
+        return this->triggers == 0 ? 0 : this->totalLateness / this->triggers;
+    }
+};
+#endif
+
+class Delay;
+class DelayPolicy;
+class DelayScheduler;
+
+#if defined(DELAY_HAS_COROUTINES)
+struct DelayAwaiter;
+#endif
+
+/**
+ * @brief Intrusive link fields used by the DelayScheduler.
+ *
+ * The links are stored inside each Delay object, so the scheduler never
+ * allocates memory. Copying a Delay object does not copy its links: a copy
+ * is never registered in a scheduler.
+ */
+struct DelayLink {
+    /**
+     * @brief The scheduler the Delay object is registered in.
+     */
+    DelayScheduler* scheduler = nullptr;
+
+    /**
+     * @brief The previous Delay object in the deadline-ordered list.
+     */
+    Delay* prev = nullptr;
+
+    /**
+     * @brief The next Delay object in the deadline-ordered list.
+     */
+    Delay* next = nullptr;
+
+    /**
+     * @brief The run() pass of the scheduler that last checked the object,
+     * zero if none.
+     */
+    unsigned int pass = 0;
+
+    DelayLink() = default;
+    DelayLink(const DelayLink&) {}
+    DelayLink& operator=(const DelayLink&) { return *this; }
+};
+
 /**
  * @brief This class facilitates creating non-blocking delays and timeouts.
  * @class Delay
@@ -75,6 +327,146 @@ private:
      */
     CallbackFunction callbackFunction = nullptr;
 
+    /**
+     * @brief Stores the callback function with a user context.
+     *
+     * Only one of `callbackFunction` and `contextCallbackFunction` is set
+     * at a time.
+     */
+    ContextCallbackFunction contextCallbackFunction = nullptr;
+
+    /**
+     * @brief The user context passed to `contextCallbackFunction`.
+     */
+    void* callbackContext = nullptr;
+
+    /**
+     * @brief Calls a functor stored by reference.
+     *
+     * @tparam Functor The type of the functor.
+     * @param[in] functor The pointer to the functor.
+     */
+    template <typename Functor>
+    static void invokeFunctor(void* functor) {
+        (*static_cast<Functor*>(functor))();
+    }
+
+    /**
+     * @brief The number of whole periods missed before the last trigger.
+     *
+     * Only updated in the `DelayMode::Periodic` mode.
+     */
+    unsigned long missed = 0;
+
+    /**
+     * @brief The scheduling mode of the Delay object.
+     */
+    DelayMode mode = DelayMode::Reset;
+
+    /**
+     * @brief The policy for missed periods in the `DelayMode::Periodic`
+     * mode.
+     */
+    DelayCatchUp catchUp = DelayCatchUp::Skip;
+
+    /**
+     * @brief The priority class in a DelayScheduler.
+     */
+    DelayPriority priority = DelayPriority::Normal;
+
+    /**
+     * @brief The time in milliseconds the object may trigger after its
+     * deadline, so the scheduler can merge wakeups.
+     */
+    uint16_t slack = 0;
+
+    /**
+     * @brief The policy that sets the next interval on each trigger,
+     * nullptr for a fixed interval.
+     */
+    DelayPolicy* policy = nullptr;
+
+    /**
+     * @brief Moves the timestamp to the next deadline in the
+     * `DelayMode::Periodic` mode.
+     *
+     * @param[in] delta The time elapsed since the timestamp, in
+     * milliseconds.
+     */
+    void advance(unsigned long delta);
+
+    /**
+     * @brief Ends the suspend state and continues the interval.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void resume(unsigned long now);
+
+    /**
+     * @brief The links of the Delay object in a DelayScheduler.
+     */
+    DelayLink link;
+
+    /**
+     * @brief Removes a destroyed object from the DelayHardwareTimer.
+     *
+     * Set by DelayHardwareTimer::add(), so sketches that do not use the
+     * timer do not link it and its interrupt handler.
+     */
+    static bool (*hardwareTimerRemove)(Delay& delay);
+
+    /**
+     * @brief Calculates the time left until the next state change.
+     *
+     * The state changes when the interval expires or, for a suspended
+     * object, when the suspend time is over.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The time left in milliseconds, zero if the change is due, or
+     * `ULONG_MAX` if the object is disabled.
+     */
+    unsigned long timeToNext(unsigned long now);
+
+    /**
+     * @brief Notifies the scheduler that the deadline has changed.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void reschedule(unsigned long now);
+
+#if DELAY_ENABLE_PROFILER
+    /**
+     * @brief The tag that names the object in the DelayProfiler.
+     */
+    uint16_t tag = 0;
+#endif
+
+#if DELAY_ENABLE_STATS
+    /**
+     * @brief The timing statistics of the object.
+     */
+    DelayStats stats;
+
+    /**
+     * @brief Records the lateness of a trigger.
+     *
+     * @param[in] lateness The time between the deadline and the poll, in
+     * milliseconds.
+     */
+    void recordLateness(unsigned long lateness);
+
+    /**
+     * @brief Records the execution time of a callback.
+     *
+     * @param[in] time The execution time in microseconds.
+     */
+    void recordCallbackTime(unsigned long time);
+#endif
+
+    friend class DelayScheduler;
+    friend class DelayHardwareTimer;
+
 public:
     /**
      * @brief Indicates whether the timer is active.
@@ -100,9 +492,10 @@ public:
     /**
      * @brief Destructor.
      *
-     * Destroys the Delay object, performing any necessary cleanup.
+     * Destroys the Delay object, performing any necessary cleanup. The
+     * object is removed from its scheduler, if any.
      */
-    ~Delay() = default;
+    ~Delay();
 
     /**
      * @brief Enables the Delay object and cancels any active suspend state.
@@ -118,6 +511,14 @@ public:
      */
     void enable();
 
+    /**
+     * @brief Enables the Delay object using the given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void enable(unsigned long now);
+
     /**
      * @brief Disables the Delay object and cancels any active suspend state.
      *
@@ -130,6 +531,29 @@ public:
      */
     void disable();
 
+    /**
+     * @brief Arms the Delay object again from the current time.
+     *
+     * Meant for the `DelayMode::OneShot` mode: the object becomes active
+     * and triggers once after the interval. Same as enable().
+     */
+    void restart();
+
+    /**
+     * @brief Arms the Delay object again from the given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void restart(unsigned long now);
+
+    /**
+     * @brief Cancels a pending trigger of the Delay object.
+     *
+     * Same as disable(). The object triggers again only after restart().
+     */
+    void cancel();
+
     /**
      * @brief Suspends the Delay object for a specified amount of time.
      *
@@ -152,6 +576,44 @@ public:
      */
     void suspend(unsigned long suspendTime, bool shouldContinue = false);
 
+    /**
+     * @brief Suspends the Delay object using the given current time.
+     *
+     * @param[in] suspendTime The amount of time to suspend the Delay object,
+     * in milliseconds.
+     * @param[in] shouldContinue If set to `true`, the timer will continue
+     * counting from where it left off before being suspended.
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void suspend(unsigned long suspendTime, bool shouldContinue,
+                 unsigned long now);
+
+    /**
+     * @brief Moves the next deadline of the Delay object later.
+     *
+     * An active object fires `offset` milliseconds later than it would
+     * have, and a suspended object resumes `offset` milliseconds later. A
+     * disabled object is not changed.
+     *
+     * @param[in] offset The time to move the deadline by, in milliseconds.
+     *
+     * @note When the offset is longer than the time elapsed in the current
+     * interval, the object is suspended until the moved start of the
+     * interval, so `isActive` is `false` in the meantime.
+     */
+    void shift(unsigned long offset);
+
+    /**
+     * @brief Moves the next deadline of the Delay object later using the
+     * given current time.
+     *
+     * @param[in] offset The time to move the deadline by, in milliseconds.
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void shift(unsigned long offset, unsigned long now);
+
     /**
      * @brief Configures the delay interval for the Delay object.
      *
@@ -162,6 +624,16 @@ public:
      */
     void setInterval(unsigned long interval);
 
+    /**
+     * @brief Configures the delay interval and restarts the timer at the
+     * given current time.
+     *
+     * @param[in] interval The desired delay time in milliseconds.
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void setInterval(unsigned long interval, unsigned long now);
+
     /**
      * @brief Retrieves the configured delay interval of the Delay obj.
      *
@@ -172,6 +644,125 @@ public:
      */
     unsigned long getInterval();
 
+    /**
+     * @brief Sets the scheduling mode of the Delay object.
+     *
+     * In the `DelayMode::Periodic` mode the next deadline is calculated as
+     * the previous deadline plus the interval, so the lateness of the poll
+     * does not accumulate.
+     *
+     * @param[in] mode The scheduling mode.
+     * @param[in] catchUp (Optional) The policy for missed periods in the
+     * `DelayMode::Periodic` mode. Defaults to `DelayCatchUp::Skip`.
+     */
+    void setMode(DelayMode mode, DelayCatchUp catchUp = DelayCatchUp::Skip);
+
+    /**
+     * @brief Retrieves the scheduling mode of the Delay object.
+     *
+     * @return The scheduling mode.
+     */
+    DelayMode getMode();
+
+    /**
+     * @brief Retrieves the policy for missed periods.
+     *
+     * @return The policy for missed periods.
+     */
+    DelayCatchUp getCatchUp();
+
+    /**
+     * @brief Gets the number of periods missed before the last trigger.
+     *
+     * For the `DelayCatchUp::Burst` policy this is the number of triggers
+     * still pending to catch up.
+     *
+     * @return The number of missed periods.
+     */
+    unsigned long getMissed();
+
+    /**
+     * @brief Sets the tolerance of the deadline.
+     *
+     * The object may trigger up to `slack` milliseconds after its
+     * deadline. DelayScheduler::sleepUntilNextDeadline() uses it to wake
+     * up once for several timers whose windows overlap.
+     *
+     * @param[in] slack The tolerance in milliseconds. Defaults to 0.
+     */
+    void setSlack(uint16_t slack);
+
+    /**
+     * @brief Retrieves the tolerance of the deadline.
+     *
+     * @return The tolerance in milliseconds.
+     */
+    uint16_t getSlack();
+
+    /**
+     * @brief Sets the priority class of the object in a DelayScheduler.
+     *
+     * @param[in] priority The priority class. Defaults to
+     * `DelayPriority::Normal`.
+     */
+    void setPriority(DelayPriority priority);
+
+    /**
+     * @brief Retrieves the priority class of the object.
+     *
+     * @return The priority class.
+     */
+    DelayPriority getPriority();
+
+    /**
+     * @brief Sets the policy that adjusts the interval on each trigger.
+     *
+     * @param[in] policy The policy, nullptr for a fixed interval. It must
+     * outlive the Delay object.
+     */
+    void setPolicy(DelayPolicy* policy);
+
+    /**
+     * @brief Retrieves the interval policy.
+     *
+     * @return The policy, nullptr for a fixed interval.
+     */
+    DelayPolicy* getPolicy();
+
+#if DELAY_ENABLE_PROFILER
+    /**
+     * @brief Sets the tag that names the object in the DelayProfiler.
+     *
+     * Only available when `DELAY_ENABLE_PROFILER` is set.
+     *
+     * @param[in] tag The tag, for example an index or an ID.
+     */
+    void setTag(uint16_t tag);
+
+    /**
+     * @brief Gets the tag of the object.
+     *
+     * @return The tag, zero if not set.
+     */
+    uint16_t getTag();
+#endif
+
+#if DELAY_ENABLE_STATS
+    /**
+     * @brief Gets the timing statistics of the object.
+     *
+     * Only available when `DELAY_ENABLE_STATS` is set.
+     *
+     * @return The timing statistics.
+     */
+    const DelayStats& getStats();
+
+    /**
+     * @brief Clears the timing statistics of the object.
+     */
+    void resetStats();
+#endif
+
     /**
      * @brief Sets the callback function for the timer.
      *
@@ -182,6 +773,41 @@ public:
      */
     void setCallback(CallbackFunction fn);
 
+    /**
+     * @brief Sets the callback function with a user context for the timer.
+     *
+     * The `context` pointer is passed to the function on each call, so one
+     * function can serve many timers.
+     *
+     * @param[in] fn The callback function.
+     * @param[in] context The user context, passed to `fn` as is.
+     */
+    void setCallback(ContextCallbackFunction fn, void* context);
+
+    /**
+     * @brief Sets a functor (a capturing lambda, for example) as the
+     * callback of the timer.
+     *
+     * The functor is stored by reference, so it must outlive the timer or
+     * the next setCallback() call. Temporaries are rejected at compile
+     * time, except captureless lambdas, which convert to a plain
+     * CallbackFunction.
+     *
+     * @code
+     * int ledPin = 12;
+     * auto toggle = [&]() { digitalWrite(ledPin, !digitalRead(ledPin)); };
+     * led1Delay.setCallback(toggle);
+     * @endcode
+     *
+     * @tparam Functor The type of the functor.
+     * @param[in] functor The functor.
+     */
+    template <typename Functor>
+    void setCallback(Functor& functor) {
+        this->setCallback(&Delay::invokeFunctor<Functor>,
+                          static_cast<void*>(&functor));
+    }
+
     /**
      * @brief Checks if a callback function is set.
      *
@@ -197,10 +823,29 @@ public:
      *
      * This method returns the current callback function set for this timer.
      *
-     * @return The current callback function.
+     * @return The current callback function, or nullptr if a callback with
+     * a user context is set.
      */
     CallbackFunction getCallback();
 
+    /**
+     * @brief Retrieves the user context of the current callback function.
+     *
+     * @return The user context, or nullptr if no callback with a user
+     * context is set.
+     */
+    void* getCallbackContext();
+
+    /**
+     * @brief Invokes the callback function that is set, if any, without
+     * checking the timer.
+     *
+     * Together with isOver() it splits execCallback() into detection and
+     * execution, so the expiry can be detected in one place (an interrupt,
+     * for example) and the callback executed in another.
+     */
+    void invokeCallback();
+
     /** @brief Executes the callback function.
      *
      * This method executes the callback function if it is set and the timer
@@ -210,6 +855,19 @@ public:
      */
     bool execCallback();
 
+    /**
+     * @brief Executes the callback function using the given current time.
+     *
+     * Same as execCallback(), but the system clock is not read. This allows
+     * many timers to share a single millis() call per loop iteration.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback(unsigned long now);
+
     /**
      * @brief Resets the internal timestamp to the current time.
      *
@@ -220,6 +878,14 @@ public:
      */
     void resetTime();
 
+    /**
+     * @brief Resets the internal timestamp to the given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void resetTime(unsigned long now);
+
     /**
      * @brief Calculates the time elapsed since the last reset.
      *
@@ -233,6 +899,77 @@ public:
      */
     unsigned long getDelta();
 
+    /**
+     * @brief Calculates the time elapsed since the last reset using the
+     * given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The time difference in milliseconds.
+     */
+    unsigned long getDelta(unsigned long now);
+
+    /**
+     * @brief Calculates the time left until the Delay object triggers.
+     *
+     * @return The time left in milliseconds, zero if the object is due, or
+     * `ULONG_MAX` if it is disabled.
+     */
+    unsigned long remainingTime();
+
+    /**
+     * @brief Calculates the time left until the Delay object triggers using
+     * the given current time.
+     *
+     * For a suspended object the rest of the suspend time is included.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The time left in milliseconds, zero if the object is due, or
+     * `ULONG_MAX` if it is disabled.
+     */
+    unsigned long remainingTime(unsigned long now);
+
+    /**
+     * @brief Calculates how long a task may block before the next poll.
+     *
+     * @return The time left in milliseconds, zero if a poll is due, or
+     * `ULONG_MAX` if the object is disabled.
+     */
+    unsigned long timeUntilUpdate();
+
+    /**
+     * @brief Calculates how long a task may block before the next poll
+     * using the given current time.
+     *
+     * Unlike remainingTime(), a suspended object returns the end of the
+     * suspend: the timer resumes when it is polled, so a poll is needed
+     * then for the next deadline to come on time. The result can be used
+     * as the timeout of `ulTaskNotifyTake()` or `xQueueReceive()` instead
+     * of polling with `vTaskDelay(1)`.
+     *
+     * @code
+     * for (;;) {
+     *   unsigned long left = sensorDelay.timeUntilUpdate();
+     *   TickType_t ticks = left == ULONG_MAX ? portMAX_DELAY
+     *                                        : pdMS_TO_TICKS(left) + 1;
+     *   ulTaskNotifyTake(pdTRUE, ticks);
+     *   if (sensorDelay.isDone()) {
+     *     readSensor();
+     *   }
+     * }
+     * @endcode
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The time left in milliseconds, zero if a poll is due, or
+     * `ULONG_MAX` if the object is disabled.
+     */
+    unsigned long timeUntilUpdate(unsigned long now);
+
     /**
      * @brief Checks if the delay interval has expired.
      *
@@ -265,8 +1002,56 @@ public:
      */
     bool isOver();
 
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time.
+     *
+     * Same as isOver(), but the system clock is not read. Read millis()
+     * once per loop iteration and pass the value to all timers to avoid
+     * the repeated interrupt masking and the skew between timers polled
+     * in the same pass.
+     *
+     * @code
+     * void loop() {
+     *   unsigned long now = millis();
+     *   if (led1Delay.isOver(now)) {
+     *     // ...
+     *   }
+     *
+     *   if (led2Delay.isOver(now)) {
+     *     // ...
+     *   }
+     * }
+     * @endcode
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isOver(unsigned long now);
+
+    /**
+     * @brief Checks if the delay interval has expired and resets the timer.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
     bool isDone();
 
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time and resets the timer.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone(unsigned long now);
+
     /**
      * @brief Gets the number of times the object has become active.
      *
@@ -311,6 +1096,78 @@ public:
      * @retval false otherwise.
      */
     bool isNever();
+
+    /**
+     * @brief Saves the state of the object into a fixed-layout record.
+     *
+     * @return The snapshot of the state.
+     */
+    DelaySnapshot serialize();
+
+    /**
+     * @brief Saves the state of the object using the given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The snapshot of the state.
+     */
+    DelaySnapshot serialize(unsigned long now);
+
+    /**
+     * @brief Restores the state of the object from a snapshot.
+     *
+     * @param[in] snapshot The snapshot made by serialize().
+     * @param[in] slept (Optional) The time in milliseconds that has passed
+     * between the snapshot and the start of millis(), for example the deep
+     * sleep time measured by an RTC. Defaults to 0.
+     *
+     * @retval true If the snapshot was valid and has been restored.
+     * @retval false If its version or checksum is wrong, the object is not
+     * changed.
+     */
+    bool restore(const DelaySnapshot& snapshot, unsigned long slept = 0);
+
+    /**
+     * @brief Restores the state of the object from a snapshot using the
+     * given current time.
+     *
+     * @param[in] snapshot The snapshot made by serialize().
+     * @param[in] slept The time in milliseconds that has passed between the
+     * snapshot and the start of millis().
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @retval true If the snapshot was valid and has been restored.
+     * @retval false If its version or checksum is wrong.
+     */
+    bool restore(const DelaySnapshot& snapshot, unsigned long slept,
+                 unsigned long now);
+
+#if defined(DELAY_HAS_COROUTINES)
+    /**
+     * @brief Creates an awaitable that suspends a DelayTask coroutine for
+     * the given time.
+     *
+     * Only available with C++20 coroutines. Defined in DelayTask.h.
+     *
+     * @code
+     * DelayTask blink() {
+     *   for (;;) {
+     *     digitalWrite(LED_PIN, HIGH);
+     *     co_await Delay::for_ms(200);
+     *     digitalWrite(LED_PIN, LOW);
+     *     co_await Delay::for_ms(800);
+     *   }
+     * }
+     * @endcode
+     *
+     * @param[in] ms The time to wait in milliseconds.
+     *
+     * @return The awaitable.
+     */
+    static DelayAwaiter for_ms(unsigned long ms);
+#endif
 };
 
 #endif  // _DELAY_H
@@ -0,0 +1,85 @@
+/**
+ * @brief Provides the compile-time options of the Delay library.
+ *
+ * The options change the layout of the Delay class, so they must have the
+ * same value in the library and in the sketch. Set them with build flags
+ * (for example `build_flags = -DDELAY_ENABLE_STATS=1` in PlatformIO) or
+ * edit this file; a `#define` in the sketch does not reach the library
+ * sources.
+ */
+#ifndef _DELAY_CONFIG_H
+#define _DELAY_CONFIG_H
+
+/**
+ * @brief Enables the per-timer statistics returned by Delay::getStats().
+ *
+ * Disabled by default. When disabled, the statistics add no memory and no
+ * code to the Delay class.
+ */
+#ifndef DELAY_ENABLE_STATS
+#define DELAY_ENABLE_STATS 0
+#endif
+
+/**
+ * @brief The number of buckets of the callback time histogram.
+ *
+ * Bucket `i` counts the callbacks that took less than `4^(i + 1)`
+ * microseconds, the last bucket counts all longer callbacks.
+ */
+#ifndef DELAY_STATS_BUCKETS
+#define DELAY_STATS_BUCKETS 8
+#endif
+
+/**
+ * @brief Enables the DelayProfiler and the timer tags used by it.
+ *
+ * Disabled by default. When disabled, DelayScheduler has no profiler hooks
+ * and Delay has no tag.
+ */
+#ifndef DELAY_ENABLE_PROFILER
+#define DELAY_ENABLE_PROFILER 0
+#endif
+
+/**
+ * @brief The number of slow callbacks kept by the DelayProfiler.
+ */
+#ifndef DELAY_PROFILER_SLOTS
+#define DELAY_PROFILER_SLOTS 8
+#endif
+
+/**
+ * @brief The maximum number of Delay objects served by the
+ * DelayHardwareTimer.
+ */
+#ifndef DELAY_HW_TIMER_SLOTS
+#define DELAY_HW_TIMER_SLOTS 4
+#endif
+
+/**
+ * @brief The size in bytes of each coroutine frame in the pool of
+ * DelayTask (C++20 only).
+ *
+ * A frame holds the Delay object of the task and the locals that live
+ * across a `co_await`. Statistics and 64-bit targets need larger frames.
+ */
+#ifndef DELAY_TASK_FRAME_SIZE
+#define DELAY_TASK_FRAME_SIZE 256
+#endif
+
+/**
+ * @brief The number of coroutine frames in the pool, which is also the
+ * maximum number of running DelayTask coroutines.
+ */
+#ifndef DELAY_TASK_FRAMES
+#define DELAY_TASK_FRAMES 4
+#endif
+
+// Detected, not an option: set when the compiler supports C++20
+// coroutines and the standard library has the <coroutine> header.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define DELAY_HAS_COROUTINES 1
+#endif
+#endif
+
+#endif  // _DELAY_CONFIG_H
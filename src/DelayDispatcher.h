@@ -0,0 +1,219 @@
+/**
+ * @brief Provides a deferred callback queue that detects expired Delay
+ * objects in an interrupt and executes their callbacks in the main loop.
+ *
+ */
+#ifndef _DELAY_DISPATCHER_H
+#define _DELAY_DISPATCHER_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class detects expired Delay objects in an interrupt and runs
+ * their callbacks later in loop().
+ * @class DelayDispatcher
+ *
+ * tick() is cheap and is meant to be called from a timer interrupt, so the
+ * deadlines are detected precisely. The expired objects are pushed into a
+ * lock-free single-producer/single-consumer ring, and dispatchPending()
+ * executes their callbacks in loop(), where Serial, I2C and other
+ * interrupt-unsafe code can be used.
+ *
+ * @code
+ * Delay sensorDelay(10);
+ * DelayDispatcher<4> dispatcher;
+ *
+ * ISR(TIMER1_COMPA_vect) {
+ *   dispatcher.tick();
+ * }
+ *
+ * void setup() {
+ *   sensorDelay.setCallback(readSensor);
+ *   dispatcher.add(sensorDelay);
+ *   // ... configure Timer1 to interrupt every millisecond.
+ * }
+ *
+ * void loop() {
+ *   dispatcher.dispatchPending();
+ * }
+ * @endcode
+ *
+ * @note The registered Delay objects are modified by tick() in the
+ * interrupt. Reconfigure them from loop() only with interrupts disabled,
+ * and do not register them in a DelayScheduler at the same time. The ring
+ * is safe between an interrupt and the main loop of a single core.
+ *
+ * @tparam Capacity The maximum number of registered Delay objects.
+ * @tparam QueueSize The maximum number of pending callbacks.
+ */
+template <uint8_t Capacity, uint8_t QueueSize = Capacity>
+class DelayDispatcher {
+private:
+    /**
+     * @brief The registered Delay objects.
+     */
+    Delay* timers[Capacity];
+
+    /**
+     * @brief The number of registered Delay objects.
+     */
+    volatile uint8_t size = 0;
+
+    /**
+     * @brief The ring of expired Delay objects. One slot is kept free to
+     * tell a full ring from an empty one.
+     */
+    Delay* volatile queue[QueueSize + 1];
+
+    /**
+     * @brief The index of the next object to dispatch, written only by
+     * the consumer (loop()).
+     */
+    volatile uint8_t head = 0;
+
+    /**
+     * @brief The index of the next free slot, written only by the producer
+     * (the interrupt).
+     */
+    volatile uint8_t tail = 0;
+
+    /**
+     * @brief The number of expiries lost because the ring was full.
+     */
+    volatile uint8_t dropped = 0;
+
+    /**
+     * @brief Calculates the ring index that follows the given one.
+     *
+     * @param[in] index The ring index.
+     *
+     * @return The next ring index.
+     */
+    static uint8_t next(uint8_t index) {
+        return index == QueueSize ? 0 : index + 1;
+    }
+
+public:
+    /**
+     * @brief Registers the Delay object in the dispatcher.
+     *
+     * Call it before the interrupt is enabled, or with interrupts
+     * disabled.
+     *
+     * @param[in] delay The Delay object to register.
+     *
+     * @return `true` if the object was registered, `false` if the
+     * dispatcher is full.
+     */
+    bool add(Delay& delay) {
+        if (this->size >= Capacity) {
+            return false;
+        }
+
+        this->timers[this->size] = &delay;
+        this->size = this->size + 1;
+        return true;
+    }
+
+    /**
+     * @brief Detects the expired Delay objects and queues them.
+     *
+     * Meant to be called from an interrupt. Reads the clock once.
+     *
+     * @return The number of queued Delay objects.
+     */
+    uint8_t tick() {
+        return this->tick(millis());
+    }
+
+    /**
+     * @brief Detects the expired Delay objects using the given current time
+     * and queues them.
+     *
+     * Each registered object is checked with isOver(), which also resets or
+     * advances it. The callbacks are not executed.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of queued Delay objects.
+     */
+    uint8_t tick(unsigned long now) {
+        uint8_t queued = 0;
+        uint8_t position = this->tail;
+        for (uint8_t i = 0; i < this->size; i++) {
+            Delay* delay = this->timers[i];
+            if (!delay->isOver(now)) {
+                continue;
+            }
+
+            uint8_t following = next(position);
+            if (following == this->head) {
+                this->dropped = this->dropped + 1;
+                continue;
+            }
+
+            this->queue[position] = delay;
+            position = following;
+            queued++;
+        }
+
+        // Publish the new entries at once, after the slots are written.
+        this->tail = position;
+        return queued;
+    }
+
+    /**
+     * @brief Executes the callbacks of the queued Delay objects.
+     *
+     * Meant to be called from loop(). Objects expired while the callbacks
+     * run are dispatched on the next call.
+     *
+     * @return The number of executed callbacks.
+     */
+    uint8_t dispatchPending() {
+        uint8_t dispatched = 0;
+        uint8_t position = this->head;
+        uint8_t end = this->tail;
+        while (position != end) {
+            Delay* delay = this->queue[position];
+            position = next(position);
+
+            // Free the slot before the callback, which may take long.
+            this->head = position;
+            delay->invokeCallback();
+            dispatched++;
+        }
+
+        return dispatched;
+    }
+
+    /**
+     * @brief Gets the number of queued callbacks.
+     *
+     * @return The number of queued callbacks.
+     */
+    uint8_t getPending() {
+        uint8_t position = this->head;
+        uint8_t end = this->tail;
+        return end >= position ? end - position
+                               : QueueSize + 1 - position + end;
+    }
+
+    /**
+     * @brief Gets the number of expiries lost because the queue was full.
+     *
+     * @return The number of lost expiries.
+     */
+    uint8_t getDropped() {
+        return this->dropped;
+    }
+
+    /**
+     * @brief Resets the number of lost expiries to zero.
+     */
+    void resetDropped() {
+        this->dropped = 0;
+    }
+};
+
+#endif  // _DELAY_DISPATCHER_H
@@ -0,0 +1,125 @@
+/**
+ * @brief Provides a fixed-size callable wrapper for capturing lambdas.
+ *
+ */
+#ifndef _DELAY_FUNCTION_H
+#define _DELAY_FUNCTION_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class stores a capturing lambda or a functor in a buffer of
+ * fixed size.
+ * @class DelayFunction
+ *
+ * Unlike `std::function` it never allocates: the functor is copied into
+ * the internal buffer, and a functor that does not fit fails at compile
+ * time. The functor must be trivially copyable, which is the case for
+ * lambdas that capture pointers, references and plain values.
+ *
+ * The object is a functor itself, so it can be passed to
+ * Delay::setCallback() and must outlive the timer.
+ *
+ * @code
+ * DelayFunction<> toggle;
+ *
+ * void setup() {
+ *   uint8_t pin = 12;
+ *   toggle = [pin]() { digitalWrite(pin, !digitalRead(pin)); };
+ *   led1Delay.setCallback(toggle);
+ * }
+ * @endcode
+ *
+ * @tparam Size The size of the buffer in bytes. Defaults to two pointers.
+ */
+template <size_t Size = 2 * sizeof(void*)>
+class DelayFunction {
+private:
+    /**
+     * @brief The buffer with the copy of the functor.
+     */
+    alignas(void*) unsigned char storage[Size];
+
+    /**
+     * @brief Calls the functor in the buffer, nullptr if empty.
+     */
+    ContextCallbackFunction invoker = nullptr;
+
+    /**
+     * @brief Calls the functor of the given type stored in the buffer.
+     *
+     * @tparam Functor The type of the functor.
+     * @param[in] storage The pointer to the buffer.
+     */
+    template <typename Functor>
+    static void invoke(void* storage) {
+        (*static_cast<Functor*>(storage))();
+    }
+
+public:
+    /**
+     * @brief Constructs a new empty DelayFunction object.
+     */
+    DelayFunction() = default;
+
+    /**
+     * @brief Constructs a new DelayFunction object with a copy of the
+     * functor.
+     *
+     * @tparam Functor The type of the functor.
+     * @param[in] functor The functor to copy.
+     */
+    template <typename Functor>
+    DelayFunction(const Functor& functor) {
+        *this = functor;
+    }
+
+    /**
+     * @brief Replaces the stored functor with a copy of the given one.
+     *
+     * @tparam Functor The type of the functor.
+     * @param[in] functor The functor to copy.
+     *
+     * @return This object.
+     */
+    template <typename Functor>
+    DelayFunction& operator=(const Functor& functor) {
+        static_assert(sizeof(Functor) <= Size,
+                      "The functor does not fit into DelayFunction");
+        static_assert(alignof(Functor) <= alignof(void*),
+                      "The functor is over-aligned for DelayFunction");
+        static_assert(__is_trivially_copyable(Functor),
+                      "DelayFunction requires a trivially copyable functor");
+
+        memcpy(this->storage, &functor, sizeof(Functor));
+        this->invoker = &DelayFunction::invoke<Functor>;
+        return *this;
+    }
+
+    /**
+     * @brief Calls the stored functor. Does nothing if empty.
+     */
+    void operator()() {
+        if (this->invoker != nullptr) {
+            this->invoker(this->storage);
+        }
+    }
+
+    /**
+     * @brief Checks if a functor is stored.
+     *
+     * @return `true` if a functor is stored, `false` otherwise.
+     */
+    explicit operator bool() const {
+        return this->invoker != nullptr;
+    }
+
+    /**
+     * @brief Removes the stored functor.
+     */
+    void reset() {
+        this->invoker = nullptr;
+    }
+};
+
+#endif  // _DELAY_FUNCTION_H
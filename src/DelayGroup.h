@@ -0,0 +1,215 @@
+/**
+ * @brief Provides batch operations over a set of Delay objects.
+ *
+ */
+#ifndef _DELAY_GROUP_H
+#define _DELAY_GROUP_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class applies one operation to a whole set of Delay objects
+ * using a single timestamp.
+ * @class DelayGroup
+ *
+ * The members are kept in a contiguous array and every batch operation
+ * reads the clock once, so suspending or shifting all timers of a device
+ * is a tight loop and all of them keep the same phase relative to each
+ * other. The group does not own the Delay objects and they must outlive
+ * it.
+ *
+ * @code
+ * Delay sensorDelay(100);
+ * Delay reportDelay(1000);
+ * DelayGroup<4> tasks;
+ *
+ * void setup() {
+ *   tasks.add(sensorDelay);
+ *   tasks.add(reportDelay);
+ * }
+ *
+ * void onMaintenance(unsigned long duration) {
+ *   // All timers continue where they left off after the window.
+ *   tasks.suspend(duration, true);
+ * }
+ * @endcode
+ *
+ * @tparam Capacity The maximum number of Delay objects in the group.
+ */
+template <uint8_t Capacity>
+class DelayGroup {
+private:
+    /**
+     * @brief The Delay objects of the group.
+     */
+    Delay* delays[Capacity];
+
+    /**
+     * @brief The number of Delay objects in the group.
+     */
+    uint8_t size = 0;
+
+public:
+    /**
+     * @brief Adds the Delay object to the group.
+     *
+     * @param[in] delay The Delay object to add.
+     *
+     * @return `true` if the object was added, `false` if the group is
+     * full.
+     */
+    bool add(Delay& delay) {
+        if (this->size >= Capacity) {
+            return false;
+        }
+
+        this->delays[this->size++] = &delay;
+        return true;
+    }
+
+    /**
+     * @brief Removes the Delay object from the group.
+     *
+     * The last member takes the place of the removed one, so the order of
+     * the members is not kept.
+     *
+     * @param[in] delay The Delay object to remove.
+     *
+     * @return `true` if the object was removed, `false` if it is not in the
+     * group.
+     */
+    bool remove(Delay& delay) {
+        for (uint8_t i = 0; i < this->size; i++) {
+            if (this->delays[i] == &delay) {
+                this->delays[i] = this->delays[--this->size];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Enables all Delay objects of the group.
+     */
+    void enable() {
+        this->enable(millis());
+    }
+
+    /**
+     * @brief Enables all Delay objects of the group using the given current
+     * time.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void enable(unsigned long now) {
+        for (uint8_t i = 0; i < this->size; i++) {
+            this->delays[i]->enable(now);
+        }
+    }
+
+    /**
+     * @brief Disables all Delay objects of the group.
+     */
+    void disable() {
+        for (uint8_t i = 0; i < this->size; i++) {
+            this->delays[i]->disable();
+        }
+    }
+
+    /**
+     * @brief Suspends all Delay objects of the group.
+     *
+     * @param[in] suspendTime The amount of time to suspend the objects, in
+     * milliseconds.
+     * @param[in] shouldContinue (Optional) If set to `true`, each timer will
+     * continue counting from where it left off before being suspended.
+     */
+    void suspend(unsigned long suspendTime, bool shouldContinue = false) {
+        this->suspend(suspendTime, shouldContinue, millis());
+    }
+
+    /**
+     * @brief Suspends all Delay objects of the group using the given
+     * current time.
+     *
+     * @param[in] suspendTime The amount of time to suspend the objects, in
+     * milliseconds.
+     * @param[in] shouldContinue If set to `true`, each timer will continue
+     * counting from where it left off before being suspended.
+     * @param[in] now The current time in milliseconds.
+     */
+    void suspend(unsigned long suspendTime, bool shouldContinue,
+                 unsigned long now) {
+        for (uint8_t i = 0; i < this->size; i++) {
+            this->delays[i]->suspend(suspendTime, shouldContinue, now);
+        }
+    }
+
+    /**
+     * @brief Sets the same delay interval for all Delay objects of the
+     * group and restarts them together.
+     *
+     * @param[in] interval The new delay time in milliseconds.
+     */
+    void setInterval(unsigned long interval) {
+        this->setInterval(interval, millis());
+    }
+
+    /**
+     * @brief Sets the same delay interval for all Delay objects of the
+     * group and restarts them at the given current time.
+     *
+     * @param[in] interval The new delay time in milliseconds.
+     * @param[in] now The current time in milliseconds.
+     */
+    void setInterval(unsigned long interval, unsigned long now) {
+        for (uint8_t i = 0; i < this->size; i++) {
+            this->delays[i]->setInterval(interval, now);
+        }
+    }
+
+    /**
+     * @brief Moves the deadlines of all Delay objects of the group later.
+     *
+     * @param[in] offset The time to move the deadlines by, in milliseconds.
+     */
+    void shift(unsigned long offset) {
+        this->shift(offset, millis());
+    }
+
+    /**
+     * @brief Moves the deadlines of all Delay objects of the group later
+     * using the given current time.
+     *
+     * @param[in] offset The time to move the deadlines by, in milliseconds.
+     * @param[in] now The current time in milliseconds.
+     */
+    void shift(unsigned long offset, unsigned long now) {
+        for (uint8_t i = 0; i < this->size; i++) {
+            this->delays[i]->shift(offset, now);
+        }
+    }
+
+    /**
+     * @brief Gets the Delay object at the given position.
+     *
+     * @param[in] index The position, less than getSize().
+     *
+     * @return The Delay object.
+     */
+    Delay& operator[](uint8_t index) {
+        return *this->delays[index];
+    }
+
+    /**
+     * @brief Gets the number of Delay objects in the group.
+     *
+     * @return The number of Delay objects.
+     */
+    uint8_t getSize() {
+        return this->size;
+    }
+};
+
+#endif  // _DELAY_GROUP_H
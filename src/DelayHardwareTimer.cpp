@@ -0,0 +1,459 @@
+#include "DelayHardwareTimer.h"
+
+// The timer support lives in its own translation unit, so its interrupt
+// handler is linked only into sketches that use the DelayHardwareTimer
+// (see `dot_a_linkage` in library.properties).
+
+#if defined(__AVR__) && defined(TIMSK1)
+
+#include <avr/interrupt.h>
+
+/**
+ * @brief The Timer1 ticks per millisecond with the prescaler of 64.
+ */
+static const unsigned long delayTimer1TicksPerMs = F_CPU / 64 / 1000;
+
+/**
+ * @brief Enters a critical section, safe to nest and to use in the ISR.
+ *
+ * @return The saved status register.
+ */
+static inline uint8_t delayTimerLock() {
+    uint8_t state = SREG;
+    cli();
+    return state;
+}
+
+/**
+ * @brief Leaves the critical section.
+ *
+ * @param[in] state The status register saved by delayTimerLock().
+ */
+static inline void delayTimerUnlock(uint8_t state) {
+    SREG = state;
+}
+
+ISR(TIMER1_COMPA_vect) {
+    DelayHardwareTimer::handleInterrupt();
+}
+
+/**
+ * @brief Prepares the hardware timer of the backend.
+ *
+ * Timer1 runs free in the normal mode with the prescaler of 64, and each
+ * deadline is programmed into OCR1A relative to TCNT1.
+ *
+ * @return `true`, Timer1 is always available.
+ */
+bool DelayHardwareTimer::setup() {
+    uint8_t state = delayTimerLock();
+    TIMSK1 &= ~_BV(OCIE1A);
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11) | _BV(CS10);
+    delayTimerUnlock(state);
+    return true;
+}
+
+/**
+ * @brief Releases the hardware timer of the backend.
+ */
+void DelayHardwareTimer::teardown() {
+    uint8_t state = delayTimerLock();
+    TIMSK1 &= ~_BV(OCIE1A);
+    TCCR1B = 0;
+    delayTimerUnlock(state);
+}
+
+/**
+ * @brief Starts the one-shot timer of the backend.
+ *
+ * The 16-bit counter spans 262 ms at 16 MHz, so longer times are cut and
+ * the interrupt programs the rest.
+ *
+ * @param[in] us The time until the interrupt in microseconds.
+ */
+void DelayHardwareTimer::arm(unsigned long us) {
+    if (us > 250000) {
+        us = 250000;
+    }
+
+    // A compare value too close to the counter would be passed before it
+    // is written, and the interrupt would come one whole turn late.
+    unsigned long ticks = us * delayTimer1TicksPerMs / 1000;
+    if (ticks < 4) {
+        ticks = 4;
+    }
+
+    OCR1A = TCNT1 + (uint16_t)ticks;
+    TIFR1 = _BV(OCF1A);
+    TIMSK1 |= _BV(OCIE1A);
+}
+
+/**
+ * @brief Stops the one-shot timer of the backend.
+ */
+void DelayHardwareTimer::disarm() {
+    TIMSK1 &= ~_BV(OCIE1A);
+}
+
+/**
+ * @brief Does nothing, the callbacks run from the interrupt.
+ */
+void DelayHardwareTimer::poll() {}
+
+#elif defined(ESP32)
+
+#include <esp_timer.h>
+
+/**
+ * @brief The one-shot timer of the backend, nullptr until setup().
+ */
+static esp_timer_handle_t delayTimerHandle = nullptr;
+
+/**
+ * @brief Guards the objects against the timer and the other core.
+ */
+static portMUX_TYPE delayTimerMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Enters a critical section, safe to nest and to use in the ISR.
+ *
+ * @return Always zero, the spinlock keeps its own state.
+ */
+static inline uint8_t delayTimerLock() {
+    portENTER_CRITICAL_SAFE(&delayTimerMux);
+    return 0;
+}
+
+/**
+ * @brief Leaves the critical section.
+ *
+ * @param[in] state Unused.
+ */
+static inline void delayTimerUnlock(uint8_t state) {
+    (void)state;
+    portEXIT_CRITICAL_SAFE(&delayTimerMux);
+}
+
+/**
+ * @brief The callback of the esp_timer.
+ */
+static void delayTimerCallback(void*) {
+    DelayHardwareTimer::handleInterrupt();
+}
+
+/**
+ * @brief Prepares the hardware timer of the backend.
+ *
+ * Called outside the critical section, as esp_timer_create() allocates.
+ *
+ * @return `true` if the esp_timer has been created, `false` otherwise.
+ */
+bool DelayHardwareTimer::setup() {
+    if (delayTimerHandle != nullptr) {
+        return true;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = delayTimerCallback;
+    args.name = "delay";
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+    args.dispatch_method = ESP_TIMER_ISR;
+#endif
+    return esp_timer_create(&args, &delayTimerHandle) == ESP_OK;
+}
+
+/**
+ * @brief Releases the hardware timer of the backend.
+ *
+ * Called outside the critical section, as esp_timer_delete() frees memory.
+ */
+void DelayHardwareTimer::teardown() {
+    if (delayTimerHandle != nullptr) {
+        esp_timer_stop(delayTimerHandle);
+        esp_timer_delete(delayTimerHandle);
+        delayTimerHandle = nullptr;
+    }
+}
+
+/**
+ * @brief Starts the one-shot timer of the backend.
+ *
+ * @param[in] us The time until the interrupt in microseconds.
+ */
+void DelayHardwareTimer::arm(unsigned long us) {
+    if (delayTimerHandle == nullptr) {
+        return;
+    }
+
+    // Restarting a running one-shot timer is an error, so stop it first.
+    esp_timer_stop(delayTimerHandle);
+    esp_timer_start_once(delayTimerHandle, us);
+}
+
+/**
+ * @brief Stops the one-shot timer of the backend.
+ */
+void DelayHardwareTimer::disarm() {
+    if (delayTimerHandle != nullptr) {
+        esp_timer_stop(delayTimerHandle);
+    }
+}
+
+/**
+ * @brief Does nothing, the callbacks run from the esp_timer.
+ */
+void DelayHardwareTimer::poll() {}
+
+#else
+
+/**
+ * @brief The time (in microseconds) poll() runs the callbacks at.
+ */
+static unsigned long delayTimerWakeup = 0;
+
+/**
+ * @brief Indicates whether a wake-up is pending.
+ */
+static bool delayTimerArmed = false;
+
+/**
+ * @brief Enters a critical section.
+ *
+ * @return Always zero.
+ */
+static inline uint8_t delayTimerLock() {
+    noInterrupts();
+    return 0;
+}
+
+/**
+ * @brief Leaves the critical section.
+ *
+ * @param[in] state Unused.
+ */
+static inline void delayTimerUnlock(uint8_t state) {
+    (void)state;
+    interrupts();
+}
+
+/**
+ * @brief There is no hardware timer on this architecture.
+ *
+ * @return `false`, the callbacks are run by poll().
+ */
+bool DelayHardwareTimer::setup() {
+    return false;
+}
+
+/**
+ * @brief Does nothing, there is no hardware timer.
+ */
+void DelayHardwareTimer::teardown() {}
+
+/**
+ * @brief Records the wake-up time for poll().
+ *
+ * @param[in] us The time until the wake-up in microseconds.
+ */
+void DelayHardwareTimer::arm(unsigned long us) {
+    delayTimerWakeup = micros() + us;
+    delayTimerArmed = true;
+}
+
+/**
+ * @brief Cancels the pending wake-up.
+ */
+void DelayHardwareTimer::disarm() {
+    delayTimerArmed = false;
+}
+
+/**
+ * @brief Runs the due callbacks when the programmed wake-up has come.
+ */
+void DelayHardwareTimer::poll() {
+    if (!delayTimerArmed || (long)(micros() - delayTimerWakeup) < 0) {
+        return;
+    }
+
+    handleInterrupt();
+}
+
+#endif
+
+Delay* DelayHardwareTimer::delays[DELAY_HW_TIMER_SLOTS];
+uint8_t DelayHardwareTimer::size = 0;
+bool DelayHardwareTimer::isRunning = false;
+
+/**
+ * @brief Gets the time until the earliest deadline of the objects.
+ *
+ * The deadlines are whole milliseconds of millis(), so the part of the
+ * current millisecond that has already passed is subtracted. On AVR
+ * millis() advances in steps of 1.024 ms, so the interrupt may come a
+ * little early, find nothing due and program the rest.
+ *
+ * @param[in] now The current time in milliseconds.
+ *
+ * @return The time left in microseconds, zero if a deadline is due, or
+ * `ULONG_MAX` if all objects are disabled.
+ */
+unsigned long DelayHardwareTimer::timeUntilNext(unsigned long now) {
+    unsigned long next = ULONG_MAX;
+    for (uint8_t i = 0; i < size; i++) {
+        unsigned long left = delays[i]->timeToNext(now);
+        if (left < next) {
+            next = left;
+        }
+    }
+
+    if (next == 0 || next == ULONG_MAX) {
+        return next;
+    }
+
+    if (next > 60000) {
+        next = 60000;
+    }
+
+    return next * 1000 - micros() % 1000;
+}
+
+/**
+ * @brief Programs the timer for the earliest deadline, or stops it.
+ *
+ * Must be called in the critical section.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void DelayHardwareTimer::program(unsigned long now) {
+    if (!isRunning) {
+        return;
+    }
+
+    unsigned long us = timeUntilNext(now);
+    if (us == ULONG_MAX) {
+        disarm();
+    } else {
+        arm(us);
+    }
+}
+
+/**
+ * @brief Starts the hardware timer.
+ *
+ * @return `true` if a hardware backend is available, `false` if the
+ * callbacks have to be run with poll().
+ */
+bool DelayHardwareTimer::begin() {
+    // The backend may allocate (esp_timer_create()), so it is prepared
+    // outside the critical section.
+    bool hasBackend = setup();
+
+    uint8_t state = delayTimerLock();
+    isRunning = true;
+    program(millis());
+    delayTimerUnlock(state);
+    return hasBackend;
+}
+
+/**
+ * @brief Stops the hardware timer. The objects stay registered.
+ */
+void DelayHardwareTimer::end() {
+    uint8_t state = delayTimerLock();
+    isRunning = false;
+    disarm();
+    delayTimerUnlock(state);
+
+    // No interrupt arms the timer again once `isRunning` is cleared, so
+    // the backend is released outside the critical section.
+    teardown();
+}
+
+/**
+ * @brief Adds the Delay object to the objects served by the timer.
+ *
+ * @param[in] delay The Delay object to add.
+ *
+ * @return `true` if the object was added, `false` if it is already served
+ * or `DELAY_HW_TIMER_SLOTS` objects are served.
+ */
+bool DelayHardwareTimer::add(Delay& delay) {
+    uint8_t state = delayTimerLock();
+    bool added = size < DELAY_HW_TIMER_SLOTS;
+    for (uint8_t i = 0; i < size && added; i++) {
+        added = delays[i] != &delay;
+    }
+
+    if (added) {
+        // A destroyed object removes itself, see Delay::~Delay().
+        Delay::hardwareTimerRemove = remove;
+        delays[size++] = &delay;
+        program(millis());
+    }
+
+    delayTimerUnlock(state);
+    return added;
+}
+
+/**
+ * @brief Removes the Delay object from the objects served by the timer.
+ *
+ * The last object takes the place of the removed one.
+ *
+ * @param[in] delay The Delay object to remove.
+ *
+ * @return `true` if the object was removed, `false` if it is not served.
+ */
+bool DelayHardwareTimer::remove(Delay& delay) {
+    uint8_t state = delayTimerLock();
+    bool removed = false;
+    for (uint8_t i = 0; i < size; i++) {
+        if (delays[i] == &delay) {
+            delays[i] = delays[--size];
+            removed = true;
+            program(millis());
+            break;
+        }
+    }
+
+    delayTimerUnlock(state);
+    return removed;
+}
+
+/**
+ * @brief Programs the timer again after the objects were changed from the
+ * main code.
+ */
+void DelayHardwareTimer::update() {
+    uint8_t state = delayTimerLock();
+    program(millis());
+    delayTimerUnlock(state);
+}
+
+/**
+ * @brief Runs the due callbacks and programs the next deadline.
+ *
+ * Called by the backend from the timer interrupt.
+ */
+void DelayHardwareTimer::handleInterrupt() {
+    uint8_t state = delayTimerLock();
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < size; i++) {
+        if (delays[i]->isOver(now)) {
+            delays[i]->invokeCallback();
+        }
+    }
+
+    program(now);
+    delayTimerUnlock(state);
+}
+
+/**
+ * @brief Gets the number of Delay objects served by the timer.
+ *
+ * @return The number of Delay objects.
+ */
+uint8_t DelayHardwareTimer::getSize() {
+    return size;
+}
@@ -0,0 +1,186 @@
+/**
+ * @brief Provides exact-deadline callbacks from a hardware timer interrupt.
+ *
+ */
+#ifndef _DELAY_HARDWARE_TIMER_H
+#define _DELAY_HARDWARE_TIMER_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class runs the callbacks of a few Delay objects from a
+ * hardware timer interrupt, programmed for the earliest of their deadlines.
+ * @class DelayHardwareTimer
+ *
+ * Callbacks polled from loop() are late by up to the longest pass of the
+ * loop. The DelayHardwareTimer programs the next deadline of its objects
+ * into a one-shot hardware timer instead, so the callback runs when the
+ * deadline expires, whatever loop() is doing.
+ *
+ * The backends are:
+ * - AVR: the output compare A of Timer1 (TIMER1_COMPA_vect), with a 4 µs
+ *   tick at 16 MHz. Timer1 can not be used for anything else, which
+ *   excludes the Servo library and analogWrite() on pins 9 and 10.
+ * - ESP32: a one-shot `esp_timer`, dispatched from the interrupt when the
+ *   IDF supports it and from the esp_timer task otherwise.
+ * - Elsewhere there is no backend: begin() returns `false` and poll()
+ *   must be called from loop() to run the callbacks.
+ *
+ * The callbacks run in interrupt context, so they must be short, must not
+ * block and may only touch `volatile` or atomic data. They must not add,
+ * remove or destroy objects. An object destroyed from the main code is
+ * removed from the timer by its destructor. The objects must not be
+ * registered in a DelayScheduler, and after changing one of them from the
+ * main code (enable(), setInterval(), ...) update() must be called to
+ * program the new deadline.
+ *
+ * @code
+ * Delay strobeDelay(20);
+ *
+ * void fireStrobe() {
+ *   PORTB ^= _BV(PB4);
+ * }
+ *
+ * void setup() {
+ *   strobeDelay.setMode(DelayMode::Periodic);
+ *   strobeDelay.setCallback(fireStrobe);
+ *   DelayHardwareTimer::add(strobeDelay);
+ *   DelayHardwareTimer::begin();
+ * }
+ * @endcode
+ */
+class DelayHardwareTimer {
+private:
+    /**
+     * @brief The Delay objects served by the timer.
+     *
+     * The fields are only accessed in the critical section of the
+     * backend.
+     */
+    static Delay* delays[DELAY_HW_TIMER_SLOTS];
+
+    /**
+     * @brief The number of Delay objects served by the timer.
+     */
+    static uint8_t size;
+
+    /**
+     * @brief Indicates whether begin() has been called.
+     */
+    static bool isRunning;
+
+    /**
+     * @brief Gets the time until the earliest deadline of the objects.
+     *
+     * Waits longer than a minute are cut, the interrupt then simply
+     * programs the rest.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The time left in microseconds, zero if a deadline is due, or
+     * `ULONG_MAX` if all objects are disabled.
+     */
+    static unsigned long timeUntilNext(unsigned long now);
+
+    /**
+     * @brief Programs the timer for the earliest deadline, or stops it.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    static void program(unsigned long now);
+
+    /**
+     * @brief Prepares the hardware timer of the backend.
+     *
+     * Called outside the critical section, which the backend takes itself
+     * where it needs it.
+     *
+     * @return `true` if there is a backend, `false` otherwise.
+     */
+    static bool setup();
+
+    /**
+     * @brief Releases the hardware timer of the backend.
+     *
+     * Called outside the critical section, after the timer is disarmed.
+     */
+    static void teardown();
+
+    /**
+     * @brief Starts the one-shot timer of the backend.
+     *
+     * @param[in] us The time until the interrupt in microseconds. Longer
+     * times than the backend can count are cut.
+     */
+    static void arm(unsigned long us);
+
+    /**
+     * @brief Stops the one-shot timer of the backend.
+     */
+    static void disarm();
+
+public:
+    /**
+     * @brief Starts the hardware timer.
+     *
+     * @return `true` if a hardware backend is available, `false` if the
+     * callbacks have to be run with poll().
+     */
+    static bool begin();
+
+    /**
+     * @brief Stops the hardware timer. The objects stay registered.
+     */
+    static void end();
+
+    /**
+     * @brief Adds the Delay object to the objects served by the timer.
+     *
+     * @param[in] delay The Delay object to add.
+     *
+     * @return `true` if the object was added, `false` if it is already
+     * served or `DELAY_HW_TIMER_SLOTS` objects are served.
+     */
+    static bool add(Delay& delay);
+
+    /**
+     * @brief Removes the Delay object from the objects served by the timer.
+     *
+     * @param[in] delay The Delay object to remove.
+     *
+     * @return `true` if the object was removed, `false` if it is not
+     * served.
+     */
+    static bool remove(Delay& delay);
+
+    /**
+     * @brief Programs the timer again after the objects were changed from
+     * the main code.
+     */
+    static void update();
+
+    /**
+     * @brief Runs the due callbacks when there is no hardware backend.
+     *
+     * Does nothing with a hardware backend, so a sketch can call it from
+     * loop() on every architecture.
+     */
+    static void poll();
+
+    /**
+     * @brief Runs the due callbacks and programs the next deadline.
+     *
+     * Called by the backend from the timer interrupt, not meant to be
+     * called by the sketch.
+     */
+    static void handleInterrupt();
+
+    /**
+     * @brief Gets the number of Delay objects served by the timer.
+     *
+     * @return The number of Delay objects.
+     */
+    static uint8_t getSize();
+};
+
+#endif  // _DELAY_HARDWARE_TIMER_H
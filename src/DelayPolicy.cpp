@@ -0,0 +1,148 @@
+#include "DelayPolicy.h"
+
+/**
+ * @brief Constructs a new DelayBackoffPolicy object.
+ *
+ * @param[in] initial The first interval in milliseconds.
+ * @param[in] maximum The largest interval in milliseconds.
+ * @param[in] multiplier The factor the interval is multiplied by on each
+ * trigger, at least 1.
+ * @param[in] jitter The largest random reduction of the interval, in
+ * percent, limited to 100.
+ */
+DelayBackoffPolicy::DelayBackoffPolicy(unsigned long initial,
+                                       unsigned long maximum,
+                                       uint8_t multiplier, uint8_t jitter)
+    : initial(initial),
+      maximum(maximum),
+      base(initial),
+      multiplier(multiplier == 0 ? 1 : multiplier),
+      jitter(jitter > 100 ? 100 : jitter) {
+}
+
+/**
+ * @brief Calculates the interval of the next period.
+ *
+ * The interval grows from its un-jittered value, so the jitter does not
+ * add up over the triggers. The jitter only shortens the interval, so the
+ * cap is never exceeded.
+ *
+ * @param[in] interval The interval of the period that has just ended.
+ * @param[in] lateness The lateness of the trigger, ignored.
+ *
+ * @return The next interval in milliseconds.
+ */
+unsigned long DelayBackoffPolicy::nextInterval(unsigned long interval,
+                                               unsigned long lateness) {
+    (void)interval;
+    (void)lateness;
+
+    // Compare before multiplying, so the product can not overflow.
+    if (this->base > this->maximum / this->multiplier) {
+        this->base = this->maximum;
+    } else {
+        this->base *= this->multiplier;
+    }
+
+    if (this->jitter == 0) {
+        return this->base;
+    }
+
+    // Multiply first, so short intervals keep their jitter. Only an
+    // interval that could overflow is divided first.
+    unsigned long range;
+    if (this->base > ULONG_MAX / 100) {
+        range = this->base / 100 * this->jitter;
+    } else {
+        range = this->base * this->jitter / 100;
+    }
+
+    return this->base - random(range + 1);
+}
+
+/**
+ * @brief Starts the backoff again from the initial interval.
+ *
+ * @return The initial interval.
+ */
+unsigned long DelayBackoffPolicy::reset() {
+    this->base = this->initial;
+    return this->initial;
+}
+
+/**
+ * @brief Constructs a new DelayLinearPolicy object.
+ *
+ * @param[in] step The step added on each trigger, in milliseconds.
+ * @param[in] minimum The smallest interval in milliseconds.
+ * @param[in] maximum The largest interval in milliseconds.
+ */
+DelayLinearPolicy::DelayLinearPolicy(long step, unsigned long minimum,
+                                     unsigned long maximum)
+    : step(step),
+      minimum(minimum),
+      maximum(maximum) {
+}
+
+/**
+ * @brief Calculates the interval of the next period.
+ *
+ * @param[in] interval The interval of the period that has just ended.
+ * @param[in] lateness The lateness of the trigger, ignored.
+ *
+ * @return The next interval in milliseconds.
+ */
+unsigned long DelayLinearPolicy::nextInterval(unsigned long interval,
+                                              unsigned long lateness) {
+    (void)lateness;
+
+    // The distances to the limits are compared, not the sums, so a step
+    // larger than a limit can not wrap around it.
+    if (this->step < 0) {
+        unsigned long decrement = -(unsigned long)this->step;
+        return interval <= this->minimum ||
+                       interval - this->minimum < decrement
+                   ? this->minimum
+                   : interval - decrement;
+    }
+
+    unsigned long increment = this->step;
+    return interval >= this->maximum || this->maximum - interval < increment
+               ? this->maximum
+               : interval + increment;
+}
+
+/**
+ * @brief Constructs a new DelayLoadPolicy object.
+ *
+ * @param[in] minimum The smallest interval in milliseconds.
+ * @param[in] maximum The largest interval in milliseconds.
+ * @param[in] threshold The lateness that counts as load, in milliseconds.
+ */
+DelayLoadPolicy::DelayLoadPolicy(unsigned long minimum, unsigned long maximum,
+                                 unsigned long threshold)
+    : minimum(minimum),
+      maximum(maximum),
+      threshold(threshold) {
+}
+
+/**
+ * @brief Calculates the interval of the next period.
+ *
+ * The interval backs off fast and recovers slowly, so a short burst of
+ * load does not make the timer oscillate.
+ *
+ * @param[in] interval The interval of the period that has just ended.
+ * @param[in] lateness The lateness of the trigger.
+ *
+ * @return The next interval in milliseconds.
+ */
+unsigned long DelayLoadPolicy::nextInterval(unsigned long interval,
+                                            unsigned long lateness) {
+    if (lateness > this->threshold) {
+        return interval > this->maximum / 2 ? this->maximum : interval * 2;
+    }
+
+    unsigned long next = interval - interval / 8;
+    return next < this->minimum ? this->minimum : next;
+}
@@ -0,0 +1,224 @@
+/**
+ * @brief Provides interval policies that adjust the period of a Delay
+ * object each time it triggers.
+ *
+ */
+#ifndef _DELAY_POLICY_H
+#define _DELAY_POLICY_H
+
+#include "Delay.h"
+
+/**
+ * @brief This is the base class of the interval policies.
+ * @class DelayPolicy
+ *
+ * A policy is set with Delay::setPolicy(). Each time the object triggers,
+ * the policy returns the interval of the next period. The interval starts
+ * at the current deadline (or at the poll in the `DelayMode::Reset` mode),
+ * so the timer is not reset and the phase is kept. Without a policy the
+ * interval is fixed.
+ *
+ * The policies keep state, so each Delay object needs its own policy
+ * object, which must outlive it.
+ */
+class DelayPolicy {
+public:
+    /**
+     * @brief Calculates the interval of the next period.
+     *
+     * @param[in] interval The interval of the period that has just ended,
+     * in milliseconds.
+     * @param[in] lateness The time between the deadline and the poll that
+     * triggered the object, in milliseconds.
+     *
+     * @return The next interval in milliseconds.
+     */
+    virtual unsigned long nextInterval(unsigned long interval,
+                                       unsigned long lateness) = 0;
+
+protected:
+    ~DelayPolicy() = default;
+};
+
+/**
+ * @brief This policy multiplies the interval on each trigger, up to a cap,
+ * with an optional random jitter.
+ * @class DelayBackoffPolicy
+ *
+ * @code
+ * DelayBackoffPolicy backoff(500, 30000, 2, 25);
+ * Delay reconnectDelay(500);
+ *
+ * void setup() {
+ *   reconnectDelay.setPolicy(&backoff);
+ * }
+ *
+ * void loop() {
+ *   if (reconnectDelay.isOver() && connect()) {
+ *     // Connected, so start from the initial interval next time.
+ *     reconnectDelay.setInterval(backoff.reset());
+ *     reconnectDelay.disable();
+ *   }
+ * }
+ * @endcode
+ */
+class DelayBackoffPolicy : public DelayPolicy {
+private:
+    /**
+     * @brief The first interval in milliseconds.
+     */
+    unsigned long initial;
+
+    /**
+     * @brief The largest interval in milliseconds.
+     */
+    unsigned long maximum;
+
+    /**
+     * @brief The current interval before the jitter, in milliseconds.
+     */
+    unsigned long base;
+
+    /**
+     * @brief The factor the interval is multiplied by on each trigger.
+     */
+    uint8_t multiplier;
+
+    /**
+     * @brief The largest jitter in percent of the interval.
+     */
+    uint8_t jitter;
+
+public:
+    /**
+     * @brief Constructs a new DelayBackoffPolicy object.
+     *
+     * @param[in] initial The first interval in milliseconds.
+     * @param[in] maximum The largest interval in milliseconds.
+     * @param[in] multiplier (Optional) The factor the interval is multiplied
+     * by on each trigger. Defaults to 2.
+     * @param[in] jitter (Optional) The largest random reduction of the
+     * interval, in percent. Defaults to 0.
+     */
+    DelayBackoffPolicy(unsigned long initial, unsigned long maximum,
+                       uint8_t multiplier = 2, uint8_t jitter = 0);
+
+    /**
+     * @brief Calculates the interval of the next period.
+     *
+     * @param[in] interval The interval of the period that has just ended.
+     * @param[in] lateness The lateness of the trigger, ignored.
+     *
+     * @return The next interval in milliseconds.
+     */
+    unsigned long nextInterval(unsigned long interval,
+                               unsigned long lateness) override;
+
+    /**
+     * @brief Starts the backoff again from the initial interval.
+     *
+     * @return The initial interval, to be set with Delay::setInterval().
+     */
+    unsigned long reset();
+};
+
+/**
+ * @brief This policy adds a fixed step to the interval on each trigger,
+ * within limits.
+ * @class DelayLinearPolicy
+ *
+ * A negative step makes a ramp that speeds up, for example for the
+ * acceleration of a stepper motor.
+ */
+class DelayLinearPolicy : public DelayPolicy {
+private:
+    /**
+     * @brief The step added on each trigger, in milliseconds.
+     */
+    long step;
+
+    /**
+     * @brief The smallest interval in milliseconds.
+     */
+    unsigned long minimum;
+
+    /**
+     * @brief The largest interval in milliseconds.
+     */
+    unsigned long maximum;
+
+public:
+    /**
+     * @brief Constructs a new DelayLinearPolicy object.
+     *
+     * @param[in] step The step added on each trigger, in milliseconds.
+     * @param[in] minimum The smallest interval in milliseconds.
+     * @param[in] maximum The largest interval in milliseconds.
+     */
+    DelayLinearPolicy(long step, unsigned long minimum,
+                      unsigned long maximum);
+
+    /**
+     * @brief Calculates the interval of the next period.
+     *
+     * @param[in] interval The interval of the period that has just ended.
+     * @param[in] lateness The lateness of the trigger, ignored.
+     *
+     * @return The next interval in milliseconds.
+     */
+    unsigned long nextInterval(unsigned long interval,
+                               unsigned long lateness) override;
+};
+
+/**
+ * @brief This policy slows the timer down when the loop is loaded and
+ * speeds it up again when the loop is idle.
+ * @class DelayLoadPolicy
+ *
+ * The load is measured by the lateness of the trigger: a loop that is busy
+ * with other work polls the timer late. A lateness above the threshold
+ * doubles the interval, a poll on time shortens it by one eighth, within
+ * the limits.
+ */
+class DelayLoadPolicy : public DelayPolicy {
+private:
+    /**
+     * @brief The smallest interval in milliseconds.
+     */
+    unsigned long minimum;
+
+    /**
+     * @brief The largest interval in milliseconds.
+     */
+    unsigned long maximum;
+
+    /**
+     * @brief The lateness that counts as load, in milliseconds.
+     */
+    unsigned long threshold;
+
+public:
+    /**
+     * @brief Constructs a new DelayLoadPolicy object.
+     *
+     * @param[in] minimum The smallest interval in milliseconds.
+     * @param[in] maximum The largest interval in milliseconds.
+     * @param[in] threshold The lateness that counts as load, in
+     * milliseconds.
+     */
+    DelayLoadPolicy(unsigned long minimum, unsigned long maximum,
+                    unsigned long threshold);
+
+    /**
+     * @brief Calculates the interval of the next period.
+     *
+     * @param[in] interval The interval of the period that has just ended.
+     * @param[in] lateness The lateness of the trigger.
+     *
+     * @return The next interval in milliseconds.
+     */
+    unsigned long nextInterval(unsigned long interval,
+                               unsigned long lateness) override;
+};
+
+#endif  // _DELAY_POLICY_H
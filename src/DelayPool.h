@@ -0,0 +1,433 @@
+/**
+ * @brief Provides a pool of many lightweight timers stored as
+ * structure-of-arrays.
+ *
+ */
+#ifndef _DELAY_POOL_H
+#define _DELAY_POOL_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class manages a large number of timers addressed by handles,
+ * with their fields stored in separate contiguous arrays.
+ * @class DelayPool
+ *
+ * The polling loop only reads the hot arrays: one deadline per timer and
+ * one bit per timer for the active state. The intervals and the callbacks
+ * are kept in cold arrays that are touched only for the timers that have
+ * fired. pollExpired() compares the deadlines of 32 timers at a time into
+ * a bit mask without branches, so the compiler can vectorize the
+ * comparison, and skips whole words of the active bitset when none of
+ * their timers are enabled.
+ *
+ * Each pool timer works like a Delay object in the `DelayMode::Reset`
+ * mode. The deadline is compared with the signed difference to the
+ * current time, so the interval must be shorter than half of the clock
+ * range (about 24 days for millis()).
+ *
+ * Handles are checked: methods called with `None`, an out-of-range handle
+ * or a removed one do nothing.
+ *
+ * @code
+ * DelayPool<1024> timeouts;
+ * DelayPool<1024>::Handle handles[1024];
+ *
+ * bool onConnect(uint16_t client) {
+ *   handles[client] = timeouts.add(30000);
+ *   if (handles[client] == DelayPool<1024>::None) {
+ *     return false;  // The pool is full.
+ *   }
+ *
+ *   timeouts.setCallback(handles[client], closeClient, clientContext(client));
+ *   return true;
+ * }
+ *
+ * void loop() {
+ *   timeouts.run();
+ * }
+ * @endcode
+ *
+ * @tparam Capacity The maximum number of timers in the pool.
+ */
+template <uint16_t Capacity>
+class DelayPool {
+public:
+    /**
+     * @brief The type of the handles of the pool timers.
+     */
+    typedef uint16_t Handle;
+
+    /**
+     * @brief The handle returned when the pool is full.
+     */
+    static constexpr Handle None = 0xFFFF;
+
+private:
+    static_assert(Capacity > 0 && Capacity < None,
+                  "DelayPool capacity must be between 1 and 65534");
+
+    /**
+     * @brief The number of words of the active bitset.
+     */
+    static constexpr uint16_t Words = (Capacity + 31) / 32;
+
+    /**
+     * @brief The next deadline of each timer, in milliseconds.
+     */
+    unsigned long deadlines[Words * 32];
+
+    /**
+     * @brief The active state of each timer, one bit per timer.
+     */
+    uint32_t active[Words];
+
+    /**
+     * @brief The allocated state of each handle, one bit per timer.
+     */
+    uint32_t used[Words];
+
+    /**
+     * @brief The interval of each timer, in milliseconds.
+     */
+    unsigned long intervals[Capacity];
+
+    /**
+     * @brief The callback function of each timer, nullptr if not set.
+     */
+    ContextCallbackFunction callbacks[Capacity];
+
+    /**
+     * @brief The user context of each callback.
+     */
+    void* contexts[Capacity];
+
+    /**
+     * @brief The stack of free handles.
+     */
+    Handle freeHandles[Capacity];
+
+    /**
+     * @brief The number of free handles.
+     */
+    uint16_t freeCount = Capacity;
+
+    /**
+     * @brief Compares the deadlines of one word of timers.
+     *
+     * @param[in] word The index of the word of the active bitset.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The bit mask of the expired timers with a deadline at or
+     * before `now`, active or not.
+     */
+    uint32_t expiredMask(uint16_t word, unsigned long now) {
+        const unsigned long* block = this->deadlines + word * 32;
+        uint32_t mask = 0;
+        for (uint8_t bit = 0; bit < 32; bit++) {
+            // Signed difference, so the comparison survives the rollover.
+            mask |= (uint32_t)(delayUntil(block[bit], now) <= 0) << bit;
+        }
+
+        return mask;
+    }
+
+public:
+    /**
+     * @brief Constructs a new empty DelayPool object.
+     */
+    DelayPool() {
+        for (uint16_t word = 0; word < Words; word++) {
+            this->active[word] = 0;
+            this->used[word] = 0;
+        }
+
+        // The handles are given out in ascending order.
+        for (uint16_t i = 0; i < Capacity; i++) {
+            this->freeHandles[i] = Capacity - 1 - i;
+        }
+
+        for (uint16_t i = 0; i < Words * 32; i++) {
+            this->deadlines[i] = 0;
+        }
+    }
+
+    DelayPool(const DelayPool&) = delete;
+    DelayPool& operator=(const DelayPool&) = delete;
+
+    /**
+     * @brief Adds an active timer to the pool.
+     *
+     * @param[in] interval The delay time in milliseconds.
+     *
+     * @return The handle of the timer, or `None` if the pool is full.
+     */
+    Handle add(unsigned long interval) {
+        return this->add(interval, millis());
+    }
+
+    /**
+     * @brief Adds an active timer to the pool using the given current
+     * time.
+     *
+     * @param[in] interval The delay time in milliseconds.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The handle of the timer, or `None` if the pool is full.
+     */
+    Handle add(unsigned long interval, unsigned long now) {
+        if (this->freeCount == 0) {
+            return None;
+        }
+
+        Handle handle = this->freeHandles[--this->freeCount];
+        this->used[handle / 32] |= (uint32_t)1 << (handle % 32);
+        this->callbacks[handle] = nullptr;
+        this->contexts[handle] = nullptr;
+        this->setInterval(handle, interval, now);
+        this->enable(handle, now);
+        return handle;
+    }
+
+    /**
+     * @brief Checks if the handle belongs to a timer of the pool.
+     *
+     * @param[in] handle The handle of the timer.
+     *
+     * @retval true If the handle was returned by add() and not removed.
+     * @retval false otherwise, `None` included.
+     */
+    bool isValid(Handle handle) {
+        return handle < Capacity &&
+               ((this->used[handle / 32] >> (handle % 32)) & 1) != 0;
+    }
+
+    /**
+     * @brief Removes the timer from the pool and frees its handle.
+     *
+     * @param[in] handle The handle of the timer.
+     *
+     * @return `true` if the timer was removed, `false` if the handle is
+     * not valid, for example when it was already removed.
+     */
+    bool remove(Handle handle) {
+        if (!this->isValid(handle)) {
+            return false;
+        }
+
+        this->disable(handle);
+        this->used[handle / 32] &= ~((uint32_t)1 << (handle % 32));
+        this->freeHandles[this->freeCount++] = handle;
+        return true;
+    }
+
+    /**
+     * @brief Enables the timer and restarts its interval.
+     *
+     * @param[in] handle The handle of the timer.
+     * @param[in] now The current time in milliseconds.
+     */
+    void enable(Handle handle, unsigned long now) {
+        if (!this->isValid(handle)) {
+            return;
+        }
+
+        this->deadlines[handle] = now + this->intervals[handle];
+        this->active[handle / 32] |= (uint32_t)1 << (handle % 32);
+    }
+
+    /**
+     * @brief Disables the timer.
+     *
+     * @param[in] handle The handle of the timer.
+     */
+    void disable(Handle handle) {
+        if (!this->isValid(handle)) {
+            return;
+        }
+
+        this->active[handle / 32] &= ~((uint32_t)1 << (handle % 32));
+    }
+
+    /**
+     * @brief Checks if the timer is active.
+     *
+     * @param[in] handle The handle of the timer.
+     *
+     * @retval true If the timer is active.
+     * @retval false otherwise.
+     */
+    bool isActive(Handle handle) {
+        return handle < Capacity &&
+               ((this->active[handle / 32] >> (handle % 32)) & 1) != 0;
+    }
+
+    /**
+     * @brief Restarts the interval of the timer.
+     *
+     * @param[in] handle The handle of the timer.
+     * @param[in] now The current time in milliseconds.
+     */
+    void resetTime(Handle handle, unsigned long now) {
+        if (!this->isValid(handle)) {
+            return;
+        }
+
+        this->deadlines[handle] = now + this->intervals[handle];
+    }
+
+    /**
+     * @brief Sets the interval of the timer and restarts it.
+     *
+     * The interval is limited to `0x7FFFFFFF`, about 24.8 days.
+     *
+     * @param[in] handle The handle of the timer.
+     * @param[in] interval The delay time in milliseconds.
+     * @param[in] now The current time in milliseconds.
+     */
+    void setInterval(Handle handle, unsigned long interval,
+                     unsigned long now) {
+        if (!this->isValid(handle)) {
+            return;
+        } else if (interval > 0x7FFFFFFFUL) {
+            interval = 0x7FFFFFFFUL;
+        }
+
+        this->intervals[handle] = interval;
+        this->resetTime(handle, now);
+    }
+
+    /**
+     * @brief Gets the interval of the timer.
+     *
+     * @param[in] handle The handle of the timer.
+     *
+     * @return The delay time in milliseconds, zero if the handle is not
+     * valid.
+     */
+    unsigned long getInterval(Handle handle) {
+        return this->isValid(handle) ? this->intervals[handle] : 0;
+    }
+
+    /**
+     * @brief Sets the callback function of the timer, called by run().
+     *
+     * @param[in] handle The handle of the timer.
+     * @param[in] fn The callback function, nullptr to remove it.
+     * @param[in] context The user context, passed to `fn` as is.
+     */
+    void setCallback(Handle handle, ContextCallbackFunction fn,
+                     void* context) {
+        if (!this->isValid(handle)) {
+            return;
+        }
+
+        this->callbacks[handle] = fn;
+        this->contexts[handle] = context;
+    }
+
+    /**
+     * @brief Finds the expired active timers and restarts them.
+     *
+     * The timers are reported in ascending order of their handles. When
+     * `out` is full, the remaining expired timers are left untouched and
+     * are reported by the next call.
+     *
+     * @param[in] now The current time in milliseconds.
+     * @param[out] out The array that receives the handles of the expired
+     * timers.
+     * @param[in] outSize The number of elements of `out`.
+     *
+     * @return The number of handles written to `out`.
+     */
+    uint16_t pollExpired(unsigned long now, Handle* out, uint16_t outSize) {
+        uint16_t count = 0;
+        for (uint16_t word = 0; word < Words && count < outSize; word++) {
+            if (this->active[word] == 0) {
+                continue;
+            }
+
+            uint32_t mask = this->expiredMask(word, now) & this->active[word];
+            while (mask != 0 && count < outSize) {
+                Handle handle = word * 32 + __builtin_ctzl(mask);
+                mask &= mask - 1;
+
+                this->deadlines[handle] = now + this->intervals[handle];
+                out[count++] = handle;
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Finds the expired timers and calls their callbacks.
+     *
+     * @return The number of expired timers.
+     */
+    uint16_t run() {
+        return this->run(millis());
+    }
+
+    /**
+     * @brief Finds the expired timers using the given current time and
+     * calls their callbacks.
+     *
+     * Each timer fires at most once per call, even with a zero interval.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of expired timers.
+     */
+    uint16_t run(unsigned long now) {
+        uint16_t count = 0;
+        for (uint16_t word = 0; word < Words; word++) {
+            if (this->active[word] == 0) {
+                continue;
+            }
+
+            uint32_t mask = this->expiredMask(word, now) & this->active[word];
+            while (mask != 0) {
+                Handle handle = word * 32 + __builtin_ctzl(mask);
+                mask &= mask - 1;
+
+                // A callback may have disabled or removed the timer.
+                if (!this->isActive(handle)) {
+                    continue;
+                }
+
+                this->deadlines[handle] = now + this->intervals[handle];
+                count++;
+                if (this->callbacks[handle] != nullptr) {
+                    this->callbacks[handle](this->contexts[handle]);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of timers in the pool.
+     *
+     * @return The number of timers.
+     */
+    uint16_t getSize() {
+        return Capacity - this->freeCount;
+    }
+
+    /**
+     * @brief Checks if the pool has no free handles.
+     *
+     * @retval true If the pool is full.
+     * @retval false otherwise.
+     */
+    bool isFull() {
+        return this->freeCount == 0;
+    }
+};
+
+template <uint16_t Capacity>
+constexpr typename DelayPool<Capacity>::Handle DelayPool<Capacity>::None;
+
+#endif  // _DELAY_POOL_H
@@ -0,0 +1,221 @@
+#include "DelayProfiler.h"
+#include "DelayTimeBase.h"
+
+#if DELAY_ENABLE_PROFILER
+
+/**
+ * @brief Writes a 16-bit value in little-endian order.
+ *
+ * @param[in] out The output.
+ * @param[in] value The value to write.
+ *
+ * @return The number of bytes written.
+ */
+static size_t delayWrite16(Print& out, uint16_t value) {
+    uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+    return out.write(bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Writes a 32-bit value in little-endian order.
+ *
+ * @param[in] out The output.
+ * @param[in] value The value to write.
+ *
+ * @return The number of bytes written.
+ */
+static size_t delayWrite32(Print& out, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8),
+                        (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    return out.write(bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Marks the start of a loop() pass.
+ *
+ * Call it first in loop(). The first call only starts the measurement.
+ */
+void DelayProfiler::beginLoop() {
+    // The read also keeps the rollover counter of the time base current.
+    unsigned long now = DelayTimeBase::micros32();
+    if (this->isStarted) {
+        unsigned long elapsed = delayElapsed(now, this->loopStart);
+        this->loops++;
+        this->loopTime += elapsed;
+        if (elapsed > this->maxLoopTime) {
+            this->maxLoopTime = elapsed;
+        }
+    }
+
+    this->loopStart = now;
+    this->isStarted = true;
+}
+
+/**
+ * @brief Sets the minimum callback time recorded as slow.
+ *
+ * @param[in] threshold The time in microseconds.
+ */
+void DelayProfiler::setThreshold(unsigned long threshold) {
+    this->threshold = threshold;
+}
+
+/**
+ * @brief Adds the polling time of one run() call.
+ *
+ * @param[in] time The time in microseconds.
+ */
+void DelayProfiler::addPoll(unsigned long time) {
+    this->pollTime += time;
+}
+
+/**
+ * @brief Adds the execution time of a callback.
+ *
+ * A callback of at least the threshold time is written into the ring,
+ * replacing the oldest entry when the ring is full.
+ *
+ * @param[in] tag The tag of the Delay object.
+ * @param[in] time The time in microseconds.
+ */
+void DelayProfiler::addCallback(uint16_t tag, unsigned long time) {
+    this->callbackTime += time;
+    if (time < this->threshold) {
+        return;
+    }
+
+    DelayProfilerEntry& entry = this->entries[this->next];
+    entry.tag = tag;
+    entry.time = time;
+    entry.timestamp = millis();
+
+    this->next = (this->next + 1) % DELAY_PROFILER_SLOTS;
+    if (this->filled < DELAY_PROFILER_SLOTS) {
+        this->filled++;
+    }
+}
+
+/**
+ * @brief Adds the time spent in sleep.
+ *
+ * @param[in] time The time in microseconds.
+ */
+void DelayProfiler::addIdle(unsigned long time) {
+    this->idleTime += time;
+}
+
+/**
+ * @brief Returns the number of completed loop() passes.
+ *
+ * @return The number of loop() passes.
+ */
+unsigned long DelayProfiler::getLoops() {
+    return this->loops;
+}
+
+/**
+ * @brief Returns the longest loop() pass.
+ *
+ * @return The time in microseconds.
+ */
+unsigned long DelayProfiler::getMaxLoopTime() {
+    return this->maxLoopTime;
+}
+
+/**
+ * @brief Returns the total time spent in polling.
+ *
+ * @return The time in microseconds.
+ */
+unsigned long DelayProfiler::getPollTime() {
+    return this->pollTime;
+}
+
+/**
+ * @brief Returns the total time spent in the callbacks.
+ *
+ * @return The time in microseconds.
+ */
+unsigned long DelayProfiler::getCallbackTime() {
+    return this->callbackTime;
+}
+
+/**
+ * @brief Returns the total time spent in sleep.
+ *
+ * @return The time in microseconds.
+ */
+unsigned long DelayProfiler::getIdleTime() {
+    return this->idleTime;
+}
+
+/**
+ * @brief Returns the number of recorded slow callbacks.
+ *
+ * @return The number of entries.
+ */
+uint8_t DelayProfiler::getSlowCount() {
+    return this->filled;
+}
+
+/**
+ * @brief Returns a recorded slow callback.
+ *
+ * @param[in] index The index of the entry, 0 is the oldest one.
+ *
+ * @return The entry.
+ */
+const DelayProfilerEntry& DelayProfiler::getSlow(uint8_t index) {
+    uint8_t first = (this->next + DELAY_PROFILER_SLOTS - this->filled) %
+                    DELAY_PROFILER_SLOTS;
+    return this->entries[(first + index) % DELAY_PROFILER_SLOTS];
+}
+
+/**
+ * @brief Writes the binary snapshot of the counters and the slow callbacks.
+ *
+ * The snapshot is written in one pass without a buffer, so it costs no
+ * memory. The values are written with a fixed width, whatever the size of
+ * `unsigned long` on the target.
+ *
+ * @param[in] out The output.
+ *
+ * @return The number of bytes written.
+ */
+size_t DelayProfiler::writeSnapshot(Print& out) {
+    uint8_t header[4] = {'D', 'P', SnapshotVersion, DELAY_PROFILER_SLOTS};
+    size_t written = out.write(header, sizeof(header));
+
+    written += delayWrite32(out, this->loops);
+    written += delayWrite32(out, this->loopTime);
+    written += delayWrite32(out, this->maxLoopTime);
+    written += delayWrite32(out, this->pollTime);
+    written += delayWrite32(out, this->callbackTime);
+    written += delayWrite32(out, this->idleTime);
+
+    written += out.write(this->filled);
+    for (uint8_t i = 0; i < this->filled; i++) {
+        const DelayProfilerEntry& entry = this->getSlow(i);
+        written += delayWrite16(out, entry.tag);
+        written += delayWrite32(out, entry.time);
+        written += delayWrite32(out, entry.timestamp);
+    }
+
+    return written;
+}
+
+/**
+ * @brief Clears the counters and the slow callbacks.
+ */
+void DelayProfiler::reset() {
+    this->loops = 0;
+    this->loopTime = 0;
+    this->maxLoopTime = 0;
+    this->pollTime = 0;
+    this->callbackTime = 0;
+    this->idleTime = 0;
+    this->next = 0;
+    this->filled = 0;
+}
+
+#endif  // DELAY_ENABLE_PROFILER
@@ -0,0 +1,259 @@
+/**
+ * @brief Provides a profiler of the loop load caused by the DelayScheduler.
+ *
+ */
+#ifndef _DELAY_PROFILER_H
+#define _DELAY_PROFILER_H
+
+#include "DelayScheduler.h"
+
+#if DELAY_ENABLE_PROFILER
+
+/**
+ * @brief A slow callback recorded by the DelayProfiler.
+ */
+struct DelayProfilerEntry {
+    /**
+     * @brief The tag of the Delay object, see Delay::setTag().
+     */
+    uint16_t tag;
+
+    /**
+     * @brief The execution time of the callback in microseconds.
+     */
+    unsigned long time;
+
+    /**
+     * @brief The time the callback started, as returned by millis().
+     */
+    unsigned long timestamp;
+};
+
+/**
+ * @brief This class measures how the time of each loop() pass is split
+ * between timer polling, callbacks and sleep.
+ * @class DelayProfiler
+ *
+ * The profiler is attached to a DelayScheduler, which reports the time of
+ * each run() and of each callback, and the time spent in
+ * sleepUntilNextDeadline(). beginLoop() marks the start of a loop() pass.
+ * Callbacks longer than the threshold are kept in a ring of
+ * `DELAY_PROFILER_SLOTS` entries with the tag of their timer, so the
+ * offending timer can be found by its tag.
+ *
+ * Requires `DELAY_ENABLE_PROFILER` (see DelayConfig.h). All times are
+ * measured with micros(). On AVR micros() stops in the power-down sleep,
+ * so that time is not counted at all.
+ *
+ * @code
+ * DelayProfiler profiler;
+ *
+ * void setup() {
+ *   sensorDelay.setTag(1);
+ *   displayDelay.setTag(2);
+ *   scheduler.setProfiler(&profiler);
+ *   profiler.setThreshold(2000);
+ * }
+ *
+ * void loop() {
+ *   profiler.beginLoop();
+ *   scheduler.run();
+ *
+ *   if (Serial.read() == 'p') {
+ *     profiler.writeSnapshot(Serial);
+ *     profiler.reset();
+ *   }
+ * }
+ * @endcode
+ */
+class DelayProfiler {
+private:
+    /**
+     * @brief The number of completed loop() passes.
+     */
+    unsigned long loops = 0;
+
+    /**
+     * @brief The total time of the completed loop() passes.
+     */
+    unsigned long loopTime = 0;
+
+    /**
+     * @brief The longest loop() pass.
+     */
+    unsigned long maxLoopTime = 0;
+
+    /**
+     * @brief The total time spent in run() outside of the callbacks.
+     */
+    unsigned long pollTime = 0;
+
+    /**
+     * @brief The total time spent in the callbacks.
+     */
+    unsigned long callbackTime = 0;
+
+    /**
+     * @brief The total time spent in sleepUntilNextDeadline().
+     */
+    unsigned long idleTime = 0;
+
+    /**
+     * @brief The start of the current loop() pass, as returned by micros().
+     */
+    unsigned long loopStart = 0;
+
+    /**
+     * @brief The minimum callback time that is recorded in the ring.
+     */
+    unsigned long threshold = 1000;
+
+    /**
+     * @brief The ring of slow callbacks.
+     */
+    DelayProfilerEntry entries[DELAY_PROFILER_SLOTS];
+
+    /**
+     * @brief The index of the next entry to write.
+     */
+    uint8_t next = 0;
+
+    /**
+     * @brief The number of valid entries.
+     */
+    uint8_t filled = 0;
+
+    /**
+     * @brief Indicates whether beginLoop() has been called once.
+     */
+    bool isStarted = false;
+
+public:
+    /**
+     * @brief The version of the binary snapshot format.
+     */
+    static constexpr uint8_t SnapshotVersion = 1;
+
+    /**
+     * @brief Marks the start of a loop() pass.
+     *
+     * The time since the previous call is counted as one loop() pass.
+     */
+    void beginLoop();
+
+    /**
+     * @brief Sets the minimum callback time recorded as slow.
+     *
+     * @param[in] threshold The time in microseconds. Defaults to 1000.
+     */
+    void setThreshold(unsigned long threshold);
+
+    /**
+     * @brief Adds the polling time of one run() call.
+     *
+     * Called by the DelayScheduler.
+     *
+     * @param[in] time The time in microseconds.
+     */
+    void addPoll(unsigned long time);
+
+    /**
+     * @brief Adds the execution time of a callback.
+     *
+     * Called by the DelayScheduler.
+     *
+     * @param[in] tag The tag of the Delay object.
+     * @param[in] time The time in microseconds.
+     */
+    void addCallback(uint16_t tag, unsigned long time);
+
+    /**
+     * @brief Adds the time spent in sleep.
+     *
+     * Called by the DelayScheduler.
+     *
+     * @param[in] time The time in microseconds.
+     */
+    void addIdle(unsigned long time);
+
+    /**
+     * @brief Gets the number of completed loop() passes.
+     *
+     * @return The number of loop() passes.
+     */
+    unsigned long getLoops();
+
+    /**
+     * @brief Gets the longest loop() pass.
+     *
+     * @return The time in microseconds.
+     */
+    unsigned long getMaxLoopTime();
+
+    /**
+     * @brief Gets the total time spent in polling.
+     *
+     * @return The time in microseconds.
+     */
+    unsigned long getPollTime();
+
+    /**
+     * @brief Gets the total time spent in the callbacks.
+     *
+     * @return The time in microseconds.
+     */
+    unsigned long getCallbackTime();
+
+    /**
+     * @brief Gets the total time spent in sleep.
+     *
+     * @return The time in microseconds.
+     */
+    unsigned long getIdleTime();
+
+    /**
+     * @brief Gets the number of recorded slow callbacks.
+     *
+     * @return The number of entries, up to `DELAY_PROFILER_SLOTS`.
+     */
+    uint8_t getSlowCount();
+
+    /**
+     * @brief Gets a recorded slow callback.
+     *
+     * @param[in] index The index of the entry, 0 is the oldest one.
+     *
+     * @return The entry.
+     */
+    const DelayProfilerEntry& getSlow(uint8_t index);
+
+    /**
+     * @brief Writes the binary snapshot of the counters and the slow
+     * callbacks.
+     *
+     * All values are little-endian:
+     * - `'D'`, `'P'`, the format version and `DELAY_PROFILER_SLOTS`
+     *   (4 bytes).
+     * - The number of loop() passes, the total and the longest loop time,
+     *   the polling, callback and idle times (6 x 4 bytes).
+     * - The number of slow callbacks (1 byte), then for each one, oldest
+     *   first, the tag (2 bytes), the time and the timestamp (2 x 4
+     *   bytes).
+     *
+     * @param[in] out The output, for example `Serial`.
+     *
+     * @return The number of bytes written.
+     */
+    size_t writeSnapshot(Print& out);
+
+    /**
+     * @brief Clears the counters and the slow callbacks.
+     *
+     * The current loop() pass is not interrupted.
+     */
+    void reset();
+};
+
+#endif  // DELAY_ENABLE_PROFILER
+
+#endif  // _DELAY_PROFILER_H
@@ -0,0 +1,376 @@
+#include "DelayScheduler.h"
+#include "DelayProfiler.h"
+#include "DelayTimeBase.h"
+
+/**
+ * @brief Destroys the DelayScheduler object.
+ *
+ * All registered Delay objects are detached from the scheduler, so they can
+ * be registered in another one or destroyed later.
+ */
+DelayScheduler::~DelayScheduler() {
+    for (Delay*& head : this->heads) {
+        while (head != nullptr) {
+            this->remove(*head);
+        }
+    }
+}
+
+/**
+ * @brief Inserts the Delay object into the list of its priority class by
+ * its deadline.
+ *
+ * The list is walked from the head until an object with a later deadline
+ * is found, so objects with the same deadline keep the order in which they
+ * were inserted. Disabled objects have no deadline and go to the tail.
+ *
+ * @param[in] delay The Delay object to insert.
+ * @param[in] now The current time in milliseconds.
+ */
+void DelayScheduler::insert(Delay& delay, unsigned long now) {
+    unsigned long key = delay.timeToNext(now);
+    Delay*& head = this->heads[(uint8_t)delay.priority];
+
+    Delay* prev = nullptr;
+    Delay* node = head;
+    while (node != nullptr && node->timeToNext(now) <= key) {
+        prev = node;
+        node = node->link.next;
+    }
+
+    delay.link.prev = prev;
+    delay.link.next = node;
+    if (node != nullptr) {
+        node->link.prev = &delay;
+    }
+
+    if (prev != nullptr) {
+        prev->link.next = &delay;
+    } else {
+        head = &delay;
+    }
+}
+
+/**
+ * @brief Removes the Delay object from the list.
+ *
+ * @param[in] delay The Delay object to remove.
+ */
+void DelayScheduler::unlink(Delay& delay) {
+    if (delay.link.prev != nullptr) {
+        delay.link.prev->link.next = delay.link.next;
+    } else if (this->heads[(uint8_t)delay.priority] == &delay) {
+        this->heads[(uint8_t)delay.priority] = delay.link.next;
+    }
+
+    if (delay.link.next != nullptr) {
+        delay.link.next->link.prev = delay.link.prev;
+    }
+
+    delay.link.prev = nullptr;
+    delay.link.next = nullptr;
+}
+
+/**
+ * @brief Registers the Delay object in the scheduler.
+ *
+ * The object is inserted at the position of its current deadline. If it is
+ * registered in another scheduler, it is removed from there first.
+ *
+ * @param[in] delay The Delay object to register.
+ */
+void DelayScheduler::add(Delay& delay) {
+    if (delay.link.scheduler == this) {
+        return;
+    } else if (delay.link.scheduler != nullptr) {
+        delay.link.scheduler->remove(delay);
+    }
+
+    delay.link.scheduler = this;
+    this->size++;
+    this->insert(delay, millis());
+}
+
+/**
+ * @brief Removes the Delay object from the scheduler.
+ *
+ * The object keeps its state and can still be polled directly.
+ *
+ * @param[in] delay The Delay object to remove.
+ *
+ * @return `true` if the object was registered in this scheduler,
+ * `false` otherwise.
+ */
+bool DelayScheduler::remove(Delay& delay) {
+    if (delay.link.scheduler != this) {
+        return false;
+    }
+
+    this->unlink(delay);
+    delay.link.scheduler = nullptr;
+    this->size--;
+    return true;
+}
+
+/**
+ * @brief Moves the Delay object to the position of its new deadline.
+ *
+ * @param[in] delay The Delay object to move.
+ * @param[in] now The current time in milliseconds.
+ */
+void DelayScheduler::reschedule(Delay& delay, unsigned long now) {
+    this->unlink(delay);
+    this->insert(delay, now);
+}
+
+/**
+ * @brief Triggers all Delay objects that are due.
+ *
+ * Reads the shared DelayTimeBase once, which keeps its rollover counter
+ * current, and forwards the millis() value of the read to run(now).
+ *
+ * @return The number of triggered Delay objects.
+ */
+unsigned int DelayScheduler::run() {
+    return this->run(DelayTimeBase::millis32());
+}
+
+/**
+ * @brief Triggers all Delay objects that are due using the given current
+ * time.
+ *
+ * The priority classes are served from `High` to `Low`, and only the head
+ * of each list is checked when nothing is due, however many of the objects
+ * are disabled. Each due object is checked with isOver(), which moves it
+ * to the position of its next deadline, and then its callback, if any, is
+ * executed. The callback may safely enable, disable, suspend or even
+ * destroy any Delay object.
+ *
+ * Each object is checked at most once per pass: a class is left when its
+ * head has already been checked in this pass. Timers with a zero interval
+ * or in the burst catch-up mode can therefore neither lock the loop nor
+ * take the pass from the other objects and classes. With a time budget,
+ * the pass stops serving the `Normal` and `Low` classes once the budget is
+ * used up. Their due objects stay at the heads of their lists and run
+ * first in the next pass.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The number of triggered Delay objects.
+ */
+unsigned int DelayScheduler::run(unsigned long now) {
+    unsigned int fired = 0;
+    if (++this->pass == 0) {
+        // Zero is the pass of the objects that were never checked.
+        this->pass = 1;
+    }
+
+    unsigned long start = this->budget != 0 ? micros() : 0;
+#if DELAY_ENABLE_PROFILER
+    if (this->profiler != nullptr) {
+        start = micros();
+    }
+
+    unsigned long callbacks = 0;
+#endif
+
+    for (uint8_t priority = 0; priority < Priorities; priority++) {
+        Delay*& head = this->heads[priority];
+        while (head != nullptr) {
+            Delay* delay = head;
+            if (delay->link.pass == this->pass ||
+                delay->timeToNext(now) != 0) {
+                // The head has the earliest deadline, so nothing else in
+                // this class is due, or the due ones have all been checked
+                // in this pass. Disabled objects sort to the tail, so a
+                // disabled head means the rest is disabled too.
+                break;
+            }
+
+            if (priority != (uint8_t)DelayPriority::High &&
+                this->budget != 0 && micros() - start >= this->budget) {
+                // The rest waits for the next pass, lower classes too.
+                this->overruns++;
+                priority = Priorities;
+                break;
+            }
+
+            delay->link.pass = this->pass;
+            if (delay->isOver(now)) {
+                fired++;
+#if DELAY_ENABLE_PROFILER
+                if (this->profiler != nullptr) {
+                    // The callback may destroy the object, so the tag is
+                    // read before it runs.
+                    uint16_t tag = delay->tag;
+                    unsigned long begin = micros();
+                    delay->invokeCallback();
+                    unsigned long time = micros() - begin;
+                    callbacks += time;
+                    this->profiler->addCallback(tag, time);
+                    continue;
+                }
+#endif
+                delay->invokeCallback();
+            }
+        }
+    }
+
+#if DELAY_ENABLE_PROFILER
+    if (this->profiler != nullptr) {
+        this->profiler->addPoll(micros() - start - callbacks);
+    }
+#endif
+
+    return fired;
+}
+
+/**
+ * @brief Sets the time budget of each run() pass.
+ *
+ * @param[in] budget The budget in microseconds, zero for no limit.
+ */
+void DelayScheduler::setBudget(unsigned long budget) {
+    this->budget = budget;
+}
+
+/**
+ * @brief Returns the time budget of each run() pass.
+ *
+ * @return The budget in microseconds, zero for no limit.
+ */
+unsigned long DelayScheduler::getBudget() {
+    return this->budget;
+}
+
+/**
+ * @brief Returns the number of run() passes that ran out of budget and
+ * deferred due objects.
+ *
+ * @return The number of overruns.
+ */
+unsigned long DelayScheduler::getOverruns() {
+    return this->overruns;
+}
+
+/**
+ * @brief Resets the overrun counter to zero.
+ */
+void DelayScheduler::resetOverruns() {
+    this->overruns = 0;
+}
+
+#if DELAY_ENABLE_PROFILER
+/**
+ * @brief Attaches the profiler that measures run() and
+ * sleepUntilNextDeadline().
+ *
+ * The profiler must outlive the scheduler or be detached first.
+ *
+ * @param[in] profiler The profiler, nullptr to detach it.
+ */
+void DelayScheduler::setProfiler(DelayProfiler* profiler) {
+    this->profiler = profiler;
+}
+#endif
+
+/**
+ * @brief Calculates the time left until the earliest deadline.
+ *
+ * @return The time left in milliseconds, zero if an object is due, or
+ * `ULONG_MAX` if no object is scheduled.
+ */
+unsigned long DelayScheduler::timeUntilNext() {
+    return this->timeUntilNext(DelayTimeBase::millis32());
+}
+
+/**
+ * @brief Calculates the time left until the earliest deadline using the
+ * given current time.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The time left in milliseconds, zero if an object is due, or
+ * `ULONG_MAX` if no object is scheduled.
+ */
+unsigned long DelayScheduler::timeUntilNext(unsigned long now) {
+    unsigned long next = ULONG_MAX;
+    for (Delay* head : this->heads) {
+        if (head != nullptr) {
+            unsigned long left = head->timeToNext(now);
+            if (left < next) {
+                next = left;
+            }
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief Calculates how long the scheduler may wait before the next run().
+ *
+ * @return The time left in milliseconds, zero if an object has reached the
+ * end of its slack, or `ULONG_MAX` if no object is scheduled.
+ */
+unsigned long DelayScheduler::timeUntilWakeup() {
+    return this->timeUntilWakeup(DelayTimeBase::millis32());
+}
+
+/**
+ * @brief Calculates how long the scheduler may wait using the given current
+ * time.
+ *
+ * The result is the earliest end of the window `[deadline, deadline +
+ * slack]` of all objects. Waking up then serves every object whose
+ * deadline has passed in the same run(), so timers with overlapping
+ * windows share one wakeup. The lists are ordered by deadline, so the walk
+ * of each list stops at the first deadline past the earliest window end
+ * found.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return The time left in milliseconds, zero if an object has reached the
+ * end of its slack, or `ULONG_MAX` if no object is scheduled.
+ */
+unsigned long DelayScheduler::timeUntilWakeup(unsigned long now) {
+    unsigned long wakeup = ULONG_MAX;
+    for (Delay* head : this->heads) {
+        for (Delay* node = head; node != nullptr; node = node->link.next) {
+            unsigned long left = node->timeToNext(now);
+            if (left >= wakeup) {
+                break;
+            }
+
+            unsigned long end = left + node->slack;
+            if (end < left) {
+                // Past the range of the clock, the deadline alone counts.
+                end = left;
+            }
+
+            if (end < wakeup) {
+                wakeup = end;
+            }
+        }
+    }
+
+    return wakeup;
+}
+
+/**
+ * @brief Returns the number of registered Delay objects.
+ *
+ * @return The number of registered Delay objects.
+ */
+unsigned int DelayScheduler::getSize() {
+    return this->size;
+}
+
+/**
+ * @brief Checks if no Delay object is registered.
+ *
+ * @return `true` if no Delay object is registered, `false` otherwise.
+ */
+bool DelayScheduler::isEmpty() {
+    return this->size == 0;
+}
@@ -0,0 +1,341 @@
+/**
+ * @brief Provides a scheduler that polls only the Delay objects that are
+ * actually due.
+ *
+ */
+#ifndef _DELAY_SCHEDULER_H
+#define _DELAY_SCHEDULER_H
+
+#include "Delay.h"
+
+class DelayProfiler;
+
+/**
+ * @brief Defines the sleep mode used by
+ * DelayScheduler::sleepUntilNextDeadline().
+ *
+ * - `Idle` stops only the CPU clock. The millis() timer keeps running and
+ *   wakes the MCU every millisecond, so the deadline is met exactly.
+ * - `PowerDown` stops all clocks and wakes the MCU through the watchdog.
+ *   The watchdog has a coarse resolution, so the remaining time is spent
+ *   in the `Idle` mode. Only supported on AVR, other architectures fall
+ *   back to delay().
+ */
+enum class DelaySleepMode : uint8_t {
+    Idle,
+    PowerDown
+};
+
+/**
+ * @brief This class keeps many Delay objects in a deadline-ordered list.
+ * @class DelayScheduler
+ *
+ * Polling each Delay object with execCallback() costs O(n) per loop
+ * iteration even when nothing is due. The DelayScheduler keeps the
+ * registered objects ordered by their next deadline, so run() checks only
+ * the head of the list when nothing is due and touches only the objects
+ * that have expired otherwise.
+ *
+ * The list is intrusive: the link fields live in each Delay object, so the
+ * scheduler never allocates memory and has no capacity limit. Disabled
+ * objects stay registered at the tail of the list.
+ *
+ * There is one list per priority class (see Delay::setPriority()), served
+ * from `High` to `Low`. With a time budget (see setBudget()) the due
+ * objects that do not fit into a pass wait for the next one, so a slow
+ * telemetry callback can not starve a control loop.
+ *
+ * @code
+ * Delay led1Delay(500);
+ * Delay led2Delay(750);
+ * DelayScheduler scheduler;
+ *
+ * void setup() {
+ *   led1Delay.setCallback(toggleLed1);
+ *   led2Delay.setCallback(toggleLed2);
+ *   scheduler.add(led1Delay);
+ *   scheduler.add(led2Delay);
+ * }
+ *
+ * void loop() {
+ *   scheduler.run();
+ * }
+ * @endcode
+ *
+ * @note A registered Delay object must be controlled through its methods
+ * (enable(), disable(), suspend(), ...), which keep the list in order.
+ * Writing the `isActive` field directly bypasses the scheduler.
+ */
+class DelayScheduler {
+private:
+    /**
+     * @brief The number of priority classes, see DelayPriority.
+     */
+    static constexpr uint8_t Priorities = 3;
+
+    /**
+     * @brief The Delay object with the earliest deadline of each priority
+     * class.
+     */
+    Delay* heads[Priorities] = {};
+
+    /**
+     * @brief The time budget of a run() pass in microseconds, zero for no
+     * limit.
+     */
+    unsigned long budget = 0;
+
+    /**
+     * @brief The number of run() passes that deferred due objects.
+     */
+    unsigned long overruns = 0;
+
+#if DELAY_ENABLE_PROFILER
+    /**
+     * @brief The attached profiler, nullptr if none.
+     */
+    DelayProfiler* profiler = nullptr;
+#endif
+
+    /**
+     * @brief The number of registered Delay objects.
+     */
+    unsigned int size = 0;
+
+    /**
+     * @brief The number of the current run() pass, never zero once run()
+     * has been called.
+     */
+    unsigned int pass = 0;
+
+    /**
+     * @brief Inserts the Delay object into the list by its deadline.
+     *
+     * @param[in] delay The Delay object to insert.
+     * @param[in] now The current time in milliseconds.
+     */
+    void insert(Delay& delay, unsigned long now);
+
+    /**
+     * @brief Removes the Delay object from the list.
+     *
+     * @param[in] delay The Delay object to remove.
+     */
+    void unlink(Delay& delay);
+
+    /**
+     * @brief Sleeps until the earliest deadline, see
+     * sleepUntilNextDeadline().
+     *
+     * @param[in] mode The sleep mode.
+     *
+     * @return The time spent in sleep, in milliseconds.
+     */
+    unsigned long sleep(DelaySleepMode mode);
+
+    friend class Delay;
+
+public:
+    /**
+     * @brief Constructs a new empty DelayScheduler object.
+     */
+    DelayScheduler() = default;
+
+    /**
+     * @brief Destructor.
+     *
+     * Removes all registered Delay objects from the scheduler.
+     */
+    ~DelayScheduler();
+
+    DelayScheduler(const DelayScheduler&) = delete;
+    DelayScheduler& operator=(const DelayScheduler&) = delete;
+
+    /**
+     * @brief Registers the Delay object in the scheduler.
+     *
+     * An object can be registered in only one scheduler at a time. If it is
+     * registered in another scheduler, it is moved to this one.
+     *
+     * @param[in] delay The Delay object to register.
+     */
+    void add(Delay& delay);
+
+    /**
+     * @brief Removes the Delay object from the scheduler.
+     *
+     * @param[in] delay The Delay object to remove.
+     *
+     * @return `true` if the object was registered in this scheduler,
+     * `false` otherwise.
+     */
+    bool remove(Delay& delay);
+
+    /**
+     * @brief Moves the Delay object to the position of its new deadline.
+     *
+     * Called by the Delay object itself each time its deadline changes.
+     *
+     * @param[in] delay The Delay object to move.
+     * @param[in] now The current time in milliseconds.
+     */
+    void reschedule(Delay& delay, unsigned long now);
+
+#if DELAY_ENABLE_PROFILER
+    /**
+     * @brief Attaches the profiler that measures run() and
+     * sleepUntilNextDeadline().
+     *
+     * Only available when `DELAY_ENABLE_PROFILER` is set.
+     *
+     * @param[in] profiler The profiler, nullptr to detach it.
+     */
+    void setProfiler(DelayProfiler* profiler);
+#endif
+
+    /**
+     * @brief Triggers all Delay objects that are due.
+     *
+     * @return The number of triggered Delay objects.
+     */
+    unsigned int run();
+
+    /**
+     * @brief Triggers all Delay objects that are due using the given current
+     * time.
+     *
+     * Each due object is checked with isOver() and its callback, if any, is
+     * executed. Each object is triggered at most once per registered object
+     * per call, so a zero interval can not lock the loop.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The number of triggered Delay objects.
+     */
+    unsigned int run(unsigned long now);
+
+    /**
+     * @brief Sets the time budget of each run() pass.
+     *
+     * Once a pass has used up its budget, the due objects of the `Normal`
+     * and `Low` priority classes are deferred to the next pass, while the
+     * `High` ones still run. A callback that is already running is not
+     * interrupted, so the budget is checked before each callback.
+     *
+     * @param[in] budget The budget in microseconds, zero for no limit.
+     * Defaults to zero.
+     */
+    void setBudget(unsigned long budget);
+
+    /**
+     * @brief Retrieves the time budget of each run() pass.
+     *
+     * @return The budget in microseconds, zero for no limit.
+     */
+    unsigned long getBudget();
+
+    /**
+     * @brief Gets the number of run() passes that ran out of budget and
+     * deferred due objects.
+     *
+     * @return The number of overruns.
+     */
+    unsigned long getOverruns();
+
+    /**
+     * @brief Resets the overrun counter to zero.
+     */
+    void resetOverruns();
+
+    /**
+     * @brief Calculates the time left until the earliest deadline.
+     *
+     * @return The time left in milliseconds, zero if an object is due, or
+     * `ULONG_MAX` if no object is scheduled.
+     */
+    unsigned long timeUntilNext();
+
+    /**
+     * @brief Calculates the time left until the earliest deadline using the
+     * given current time.
+     *
+     * The ends of suspends count as deadlines, as the objects resume in
+     * run(). Blocking a task (`ulTaskNotifyTake()`, `xQueueReceive()`) for
+     * this time and then calling run() serves every object on time, with
+     * one wakeup per deadline instead of one per tick.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The time left in milliseconds, zero if an object is due, or
+     * `ULONG_MAX` if no object is scheduled.
+     */
+    unsigned long timeUntilNext(unsigned long now);
+
+    /**
+     * @brief Calculates how long the scheduler may wait before the next
+     * run() and still serve every object within its slack.
+     *
+     * @return The time left in milliseconds, zero if an object has reached
+     * the end of its slack, or `ULONG_MAX` if no object is scheduled.
+     */
+    unsigned long timeUntilWakeup();
+
+    /**
+     * @brief Calculates how long the scheduler may wait using the given
+     * current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @return The time left in milliseconds, zero if an object has reached
+     * the end of its slack, or `ULONG_MAX` if no object is scheduled.
+     */
+    unsigned long timeUntilWakeup(unsigned long now);
+
+    /**
+     * @brief Puts the MCU to sleep until the earliest deadline, delayed
+     * within the slack of the objects (see Delay::setSlack()).
+     *
+     * In the `DelaySleepMode::PowerDown` mode the time spent in deep sleep
+     * is added to millis(), so all Delay objects stay in sync with the
+     * system clock. Returns immediately if an object is already due or no
+     * object is scheduled.
+     *
+     * @code
+     * void loop() {
+     *   scheduler.run();
+     *   scheduler.sleepUntilNextDeadline(DelaySleepMode::PowerDown);
+     * }
+     * @endcode
+     *
+     * @note Waking up by another interrupt (a pin change, for example)
+     * ends the deep sleep early. The time slept in the interrupted watchdog
+     * period is unknown and is not added to millis().
+     *
+     * @param[in] mode (Optional) The sleep mode. Defaults to
+     * `DelaySleepMode::Idle`.
+     *
+     * @return The time spent in sleep, in milliseconds.
+     */
+    unsigned long sleepUntilNextDeadline(
+        DelaySleepMode mode = DelaySleepMode::Idle);
+
+    /**
+     * @brief Gets the number of registered Delay objects.
+     *
+     * @return The number of registered Delay objects.
+     */
+    unsigned int getSize();
+
+    /**
+     * @brief Checks if no Delay object is registered.
+     *
+     * @retval true If no Delay object is registered.
+     * @retval false otherwise.
+     */
+    bool isEmpty();
+};
+
+#endif  // _DELAY_SCHEDULER_H
@@ -0,0 +1,131 @@
+#include "DelaySequence.h"
+
+/**
+ * @brief Reads a step from the table in flash.
+ *
+ * @param[in] index The index of the step.
+ *
+ * @return The copy of the step.
+ */
+DelayStep DelaySequence::readStep(uint8_t index) {
+    DelayStep step;
+    memcpy_P(&step, &this->steps[index], sizeof(DelayStep));
+    return step;
+}
+
+/**
+ * @brief Starts the sequence from the first step.
+ */
+void DelaySequence::start() {
+    this->start(millis());
+}
+
+/**
+ * @brief Starts the sequence from the first step using the given current
+ * time.
+ *
+ * A running sequence is restarted from the first step.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ */
+void DelaySequence::start(unsigned long now) {
+    this->index = 0;
+    this->timestamp = now;
+    this->isRunning = true;
+
+    DelayStep step = this->readStep(0);
+    if (step.action != nullptr) {
+        step.action();
+    }
+
+    // The first step may have a zero duration.
+    this->update(now);
+}
+
+/**
+ * @brief Stops the sequence.
+ */
+void DelaySequence::stop() {
+    this->isRunning = false;
+}
+
+/**
+ * @brief Advances the sequence when the current step is over.
+ *
+ * @return `true` if a new step has started or the sequence has ended,
+ * `false` otherwise.
+ */
+bool DelaySequence::update() {
+    return this->update(millis());
+}
+
+/**
+ * @brief Advances the sequence using the given current time.
+ *
+ * Each next step starts at the end of the previous one, so a late poll
+ * runs all overdue steps at once and the following steps keep their
+ * planned times. An action may stop or restart the sequence.
+ *
+ * @param[in] now The current time in milliseconds, as returned by millis().
+ *
+ * @return `true` if a new step has started or the sequence has ended,
+ * `false` otherwise.
+ */
+bool DelaySequence::update(unsigned long now) {
+    bool isChanged = false;
+
+    // One pass over the table at most, so a table of zero durations can
+    // not lock the loop.
+    for (uint8_t i = 0; i < this->size && this->isRunning; i++) {
+        DelayStep step = this->readStep(this->index);
+        if (delayElapsed(now, this->timestamp) < step.duration) {
+            break;
+        }
+
+        this->timestamp += step.duration;
+        isChanged = true;
+
+        if (this->index + 1 < this->size) {
+            this->index++;
+        } else if (this->isLooping) {
+            this->index = 0;
+        } else {
+            this->isRunning = false;
+            break;
+        }
+
+        DelayStep next = this->readStep(this->index);
+        if (next.action != nullptr) {
+            next.action();
+        }
+    }
+
+    return isChanged;
+}
+
+/**
+ * @brief Checks if the sequence is running.
+ *
+ * @return `true` if the sequence is running, `false` otherwise.
+ */
+bool DelaySequence::isStarted() {
+    return this->isRunning;
+}
+
+/**
+ * @brief Returns the index of the current step.
+ *
+ * @return The index of the current step.
+ */
+uint8_t DelaySequence::getStep() {
+    return this->index;
+}
+
+/**
+ * @brief Returns the number of steps in the table.
+ *
+ * @return The number of steps.
+ */
+uint8_t DelaySequence::getSize() {
+    return this->size;
+}
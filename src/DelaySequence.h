@@ -0,0 +1,181 @@
+/**
+ * @brief Provides a sequence engine that steps through a table of timed
+ * actions with a single timer.
+ *
+ */
+#ifndef _DELAY_SEQUENCE_H
+#define _DELAY_SEQUENCE_H
+
+#include "Delay.h"
+
+/**
+ * @brief A step of a DelaySequence.
+ *
+ * The action runs when the step starts, then the sequence waits for the
+ * duration before the next step starts.
+ */
+struct DelayStep {
+    /**
+     * @brief The time to wait after the action, in milliseconds.
+     */
+    unsigned long duration;
+
+    /**
+     * @brief The action of the step, nullptr for a plain wait.
+     */
+    CallbackFunction action;
+};
+
+/**
+ * @brief This class runs a sequence of timed steps from a constant table.
+ * @class DelaySequence
+ *
+ * The table of steps is constant and lives in flash (PROGMEM), so a
+ * sequence costs only a timestamp, a step index and a few flags in RAM,
+ * whatever the number of steps, and update() polls a single timer. The
+ * next step starts at the end of the previous one, not at the poll, so
+ * the steps do not drift.
+ *
+ * @code
+ * const DelayStep irrigation[] PROGMEM = {
+ *   {500, openValve},
+ *   {10000, pumpOn},
+ *   {0, pumpOff},
+ *   {500, closeValve},
+ * };
+ *
+ * DelaySequence irrigationSequence(irrigation);
+ *
+ * void onButton() {
+ *   irrigationSequence.start();
+ * }
+ *
+ * void loop() {
+ *   irrigationSequence.update();
+ * }
+ * @endcode
+ *
+ * @note On AVR the table must be declared with PROGMEM.
+ */
+class DelaySequence {
+private:
+    /**
+     * @brief The table of steps in flash.
+     */
+    const DelayStep* steps;
+
+    /**
+     * @brief The start time of the current step, in milliseconds.
+     */
+    unsigned long timestamp = 0;
+
+    /**
+     * @brief The number of steps in the table.
+     */
+    uint8_t size;
+
+    /**
+     * @brief The index of the current step.
+     */
+    uint8_t index = 0;
+
+    /**
+     * @brief Indicates whether the sequence is running.
+     */
+    bool isRunning = false;
+
+    /**
+     * @brief Indicates whether the sequence starts over after the last
+     * step.
+     */
+    bool isLooping;
+
+    /**
+     * @brief Reads a step from the table in flash.
+     *
+     * @param[in] index The index of the step.
+     *
+     * @return The copy of the step.
+     */
+    DelayStep readStep(uint8_t index);
+
+public:
+    /**
+     * @brief Constructs a new stopped DelaySequence object.
+     *
+     * @tparam Size The number of steps, deduced from the table.
+     * @param[in] steps The table of steps, in PROGMEM on AVR.
+     * @param[in] isLooping (Optional) If set to `true`, the sequence starts
+     * over after the last step. Defaults to `false`.
+     */
+    template <uint8_t Size>
+    DelaySequence(const DelayStep (&steps)[Size], bool isLooping = false)
+        : steps(steps),
+          size(Size),
+          isLooping(isLooping) {}
+
+    /**
+     * @brief Starts the sequence from the first step.
+     *
+     * The action of the first step runs immediately.
+     */
+    void start();
+
+    /**
+     * @brief Starts the sequence from the first step using the given
+     * current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     */
+    void start(unsigned long now);
+
+    /**
+     * @brief Stops the sequence. No further action runs.
+     */
+    void stop();
+
+    /**
+     * @brief Advances the sequence when the current step is over.
+     *
+     * @retval true If a new step has started or the sequence has ended.
+     * @retval false otherwise.
+     */
+    bool update();
+
+    /**
+     * @brief Advances the sequence using the given current time.
+     *
+     * @param[in] now The current time in milliseconds, as returned by
+     * millis().
+     *
+     * @retval true If a new step has started or the sequence has ended.
+     * @retval false otherwise.
+     */
+    bool update(unsigned long now);
+
+    /**
+     * @brief Checks if the sequence is running.
+     *
+     * @retval true If the sequence is running.
+     * @retval false If it has not been started, has been stopped or has
+     * ended.
+     */
+    bool isStarted();
+
+    /**
+     * @brief Gets the index of the current step.
+     *
+     * @return The index of the current step.
+     */
+    uint8_t getStep();
+
+    /**
+     * @brief Gets the number of steps in the table.
+     *
+     * @return The number of steps.
+     */
+    uint8_t getSize();
+};
+
+#endif  // _DELAY_SEQUENCE_H
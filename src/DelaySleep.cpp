@@ -0,0 +1,187 @@
+#include "DelayProfiler.h"
+
+// The sleep support lives in its own translation unit, so its watchdog
+// interrupt handler is linked only into sketches that call
+// sleepUntilNextDeadline() (see `dot_a_linkage` in library.properties).
+
+#if defined(__AVR__) && defined(WDTCSR)
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+
+// The millisecond counter maintained by the Arduino AVR core (wiring.c).
+extern volatile unsigned long timer0_millis;
+
+/**
+ * @brief The nominal watchdog periods in milliseconds, indexed by the
+ * WDP3..WDP0 prescaler value.
+ */
+static const uint16_t delayWatchdogPeriods[] = {
+    16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000};
+
+/**
+ * @brief Set by the watchdog interrupt, so a wake-up by another interrupt
+ * can be told apart.
+ */
+static volatile bool delayWatchdogFired = false;
+
+ISR(WDT_vect) {
+    delayWatchdogFired = true;
+}
+
+/**
+ * @brief Puts the MCU into the power-down mode for one watchdog period.
+ *
+ * @param[in] prescaler The WDP3..WDP0 prescaler value (0..9).
+ *
+ * @return `true` if the MCU was woken up by the watchdog, `false` if it was
+ * woken up by another interrupt.
+ */
+static bool delayPowerDown(uint8_t prescaler) {
+    uint8_t bits = (prescaler & 0x07) | ((prescaler & 0x08) ? _BV(WDP3) : 0);
+
+    cli();
+    delayWatchdogFired = false;
+    wdt_reset();
+    MCUSR &= ~_BV(WDRF);
+    WDTCSR = _BV(WDCE) | _BV(WDE);
+    WDTCSR = _BV(WDIE) | bits;
+
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+#if defined(sleep_bod_disable)
+    sleep_bod_disable();
+#endif
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    wdt_disable();
+
+    return delayWatchdogFired;
+}
+
+/**
+ * @brief Puts the MCU into the idle mode until the next interrupt.
+ *
+ * The Timer0 overflow interrupt of millis() wakes the MCU at least once per
+ * millisecond.
+ */
+static void delayIdle() {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+}
+
+/**
+ * @brief Adds the time spent in deep sleep to millis().
+ *
+ * @param[in] ms The time to add, in milliseconds.
+ */
+static void delayAddMillis(unsigned long ms) {
+    uint8_t oldSREG = SREG;
+    cli();
+    timer0_millis += ms;
+    SREG = oldSREG;
+}
+
+/**
+ * @brief Puts the MCU to sleep until the earliest deadline.
+ *
+ * The wakeup is delayed within the slack of the objects, see
+ * timeUntilWakeup(). In the power-down mode the longest watchdog periods
+ * that fit into the remaining time are slept first. The watchdog
+ * oscillator is accurate to about 10%, so a period is used only if it fits
+ * with a 1/8 margin, and the rest of the time is spent in the idle mode,
+ * where millis() keeps running.
+ *
+ * @param[in] mode The sleep mode.
+ *
+ * @return The time spent in sleep, in milliseconds.
+ */
+unsigned long DelayScheduler::sleep(DelaySleepMode mode) {
+    unsigned long start = millis();
+    unsigned long left = this->timeUntilWakeup(start);
+    if (left == 0 || left == ULONG_MAX) {
+        return 0;
+    }
+
+    if (mode == DelaySleepMode::PowerDown) {
+        uint8_t prescaler = 9;
+        while (true) {
+            uint16_t period = delayWatchdogPeriods[prescaler];
+            if (period + period / 8 <= left) {
+                bool isWatchdog = delayPowerDown(prescaler);
+                if (!isWatchdog) {
+                    // Woken up by another interrupt, it must be handled.
+                    return millis() - start;
+                }
+
+                delayAddMillis(period);
+                left -= period;
+            } else if (prescaler > 0) {
+                prescaler--;
+            } else {
+                break;
+            }
+        }
+    }
+
+    while (this->timeUntilWakeup(millis()) != 0) {
+        delayIdle();
+    }
+
+    return millis() - start;
+}
+
+#else
+
+/**
+ * @brief Waits until the earliest deadline, delayed within the slack of
+ * the objects.
+ *
+ * There is no portable sleep mode, so delay() is used. On RTOS-based cores
+ * (ESP32, for example) it blocks the task and lets the idle task lower the
+ * power consumption.
+ *
+ * @param[in] mode The sleep mode, ignored.
+ *
+ * @return The time spent waiting, in milliseconds.
+ */
+unsigned long DelayScheduler::sleep(DelaySleepMode mode) {
+    (void)mode;
+
+    unsigned long start = millis();
+    unsigned long left = this->timeUntilWakeup(start);
+    if (left == 0 || left == ULONG_MAX) {
+        return 0;
+    }
+
+    delay(left);
+    return millis() - start;
+}
+
+#endif
+
+/**
+ * @brief Puts the MCU to sleep until the earliest deadline.
+ *
+ * The time spent in sleep is reported to the profiler, if any.
+ *
+ * @param[in] mode The sleep mode.
+ *
+ * @return The time spent in sleep, in milliseconds.
+ */
+unsigned long DelayScheduler::sleepUntilNextDeadline(DelaySleepMode mode) {
+#if DELAY_ENABLE_PROFILER
+    if (this->profiler != nullptr) {
+        unsigned long start = micros();
+        unsigned long slept = this->sleep(mode);
+        this->profiler->addIdle(micros() - start);
+        return slept;
+    }
+#endif
+
+    return this->sleep(mode);
+}
@@ -0,0 +1,221 @@
+/**
+ * @brief Provides a table of timers declared at compile time, with only
+ * their timestamps in RAM.
+ *
+ */
+#ifndef _DELAY_TABLE_H
+#define _DELAY_TABLE_H
+
+#include "Delay.h"
+
+/**
+ * @brief An entry of a DelayTable: the interval, the callback and the mode
+ * of one timer, all fixed at compile time.
+ *
+ * The entry is a type, not an object, so its fields live in the code of
+ * the dispatch as immediate operands and direct calls, and take neither
+ * RAM nor a table in flash.
+ *
+ * @tparam Interval The delay time in milliseconds, more than zero.
+ * @tparam Callback The callback function.
+ * @tparam Mode (Optional) `DelayMode::Reset` (default), `Periodic` with the
+ * `DelayCatchUp::Skip` policy, or `OneShot`.
+ */
+template <unsigned long Interval, CallbackFunction Callback,
+          DelayMode Mode = DelayMode::Reset>
+struct DelayEntry {
+    static_assert(Interval > 0, "DelayEntry interval must not be zero");
+
+    static constexpr unsigned long interval = Interval;
+    static constexpr DelayMode mode = Mode;
+
+    /**
+     * @brief Calls the callback of the entry.
+     */
+    static void invoke() {
+        Callback();
+    }
+};
+
+/**
+ * @brief A list of DelayEntry types, used to walk the entries of a
+ * DelayTable at compile time.
+ */
+template <typename... Entries>
+struct DelayEntryList {};
+
+/**
+ * @brief This class polls a fixed set of timers declared at compile time.
+ * @class DelayTable
+ *
+ * The intervals, callbacks and modes are template parameters, so only the
+ * timestamps and the active bits are kept in RAM: 4 bytes per timer and
+ * one bit, against the size of a Delay object each. run() is unrolled at
+ * compile time into one compare and one direct call per entry, without
+ * loops, indirect calls or reads from a table.
+ *
+ * @code
+ * void toggleLed();
+ * void readSensor();
+ * void sendReport();
+ *
+ * DelayTable<
+ *   DelayEntry<500, toggleLed>,
+ *   DelayEntry<100, readSensor, DelayMode::Periodic>,
+ *   DelayEntry<60000, sendReport>
+ * > timers;  // 13 bytes of RAM on AVR.
+ *
+ * void loop() {
+ *   timers.run();
+ * }
+ * @endcode
+ *
+ * @tparam Entries The DelayEntry types of the timers, up to 255.
+ */
+template <typename... Entries>
+class DelayTable {
+private:
+    /**
+     * @brief The number of timers.
+     */
+    static constexpr uint8_t Size = sizeof...(Entries);
+
+    static_assert(Size > 0 && sizeof...(Entries) < 256,
+                  "DelayTable supports 1 to 255 entries");
+
+    /**
+     * @brief The last time (in milliseconds) each timer was triggered or
+     * enabled.
+     */
+    unsigned long timestamps[Size];
+
+    /**
+     * @brief The active state of each timer, one bit per timer.
+     */
+    uint8_t active[(Size + 7) / 8];
+
+    /**
+     * @brief Ends the unrolled poll after the last entry.
+     */
+    template <uint8_t Index>
+    unsigned int poll(unsigned long, DelayEntryList<>) {
+        return 0;
+    }
+
+    /**
+     * @brief Polls the entry at `Index` and then the rest of the entries.
+     *
+     * The branches on the mode are resolved at compile time.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of triggered timers from `Index` on.
+     */
+    template <uint8_t Index, typename Entry, typename... Rest>
+    unsigned int poll(unsigned long now, DelayEntryList<Entry, Rest...>) {
+        unsigned int fired = 0;
+        unsigned long delta = delayElapsed(now, this->timestamps[Index]);
+        if (delta >= Entry::interval && this->isActive(Index)) {
+            if (Entry::mode == DelayMode::Periodic) {
+                // Whole periods keep the phase, missed ones are skipped.
+                this->timestamps[Index] += delta - delta % Entry::interval;
+            } else if (Entry::mode == DelayMode::OneShot) {
+                this->active[Index / 8] &= ~(1 << (Index % 8));
+            } else {
+                this->timestamps[Index] = now;
+            }
+
+            Entry::invoke();
+            fired = 1;
+        }
+
+        return fired + this->poll<Index + 1>(now, DelayEntryList<Rest...>());
+    }
+
+public:
+    /**
+     * @brief Constructs a new DelayTable object with all timers active.
+     */
+    DelayTable() {
+        this->start(millis());
+    }
+
+    /**
+     * @brief Enables all timers and restarts their intervals.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void start(unsigned long now) {
+        for (uint8_t i = 0; i < Size; i++) {
+            this->timestamps[i] = now;
+        }
+
+        for (uint8_t i = 0; i < (Size + 7) / 8; i++) {
+            this->active[i] = 0xFF;
+        }
+    }
+
+    /**
+     * @brief Polls all timers and calls the callbacks of the expired ones.
+     *
+     * @return The number of triggered timers.
+     */
+    unsigned int run() {
+        return this->run(millis());
+    }
+
+    /**
+     * @brief Polls all timers using the given current time and calls the
+     * callbacks of the expired ones, in the order of the entries.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of triggered timers.
+     */
+    unsigned int run(unsigned long now) {
+        return this->poll<0>(now, DelayEntryList<Entries...>());
+    }
+
+    /**
+     * @brief Enables the timer and restarts its interval.
+     *
+     * @param[in] index The position of the entry.
+     * @param[in] now The current time in milliseconds.
+     */
+    void enable(uint8_t index, unsigned long now) {
+        this->timestamps[index] = now;
+        this->active[index / 8] |= 1 << (index % 8);
+    }
+
+    /**
+     * @brief Disables the timer.
+     *
+     * @param[in] index The position of the entry.
+     */
+    void disable(uint8_t index) {
+        this->active[index / 8] &= ~(1 << (index % 8));
+    }
+
+    /**
+     * @brief Checks if the timer is active.
+     *
+     * @param[in] index The position of the entry.
+     *
+     * @retval true If the timer is active.
+     * @retval false otherwise.
+     */
+    bool isActive(uint8_t index) {
+        return (this->active[index / 8] >> (index % 8)) & 1;
+    }
+
+    /**
+     * @brief Gets the number of timers.
+     *
+     * @return The number of entries.
+     */
+    static constexpr uint8_t getSize() {
+        return Size;
+    }
+};
+
+#endif  // _DELAY_TABLE_H
@@ -0,0 +1,438 @@
+/**
+ * @brief Provides cooperative coroutine tasks that wait on the
+ * DelayScheduler (C++20).
+ *
+ */
+#ifndef _DELAY_TASK_H
+#define _DELAY_TASK_H
+
+#include "DelayScheduler.h"
+
+#if defined(DELAY_HAS_COROUTINES)
+
+#include <coroutine>
+
+class DelayExecutor;
+
+/**
+ * @brief This class is a fixed pool of equally sized blocks for the
+ * coroutine frames.
+ * @class DelayFramePool
+ *
+ * The frames of all DelayTask coroutines come from a single pool, so no
+ * coroutine allocates on the heap. A coroutine whose frame does not fit
+ * into a block, or that is started when all blocks are in use, is not
+ * created at all and its DelayTask is empty.
+ *
+ * @tparam FrameSize The size of each block in bytes.
+ * @tparam Frames The number of blocks, up to 32.
+ */
+template <size_t FrameSize, uint8_t Frames>
+class DelayFramePool {
+private:
+    static_assert(Frames > 0 && Frames <= 32,
+                  "DelayFramePool supports 1 to 32 frames");
+
+    /**
+     * @brief The blocks of the pool.
+     */
+    alignas(alignof(max_align_t)) unsigned char frames[Frames][FrameSize];
+
+    /**
+     * @brief The blocks in use, one bit per block.
+     */
+    uint32_t used = 0;
+
+public:
+    /**
+     * @brief Takes a free block from the pool.
+     *
+     * @param[in] size The requested size in bytes.
+     *
+     * @return The block, or nullptr if the size does not fit or no block
+     * is free.
+     */
+    void* allocate(size_t size) noexcept {
+        if (size > FrameSize) {
+            return nullptr;
+        }
+
+        for (uint8_t i = 0; i < Frames; i++) {
+            if ((this->used & ((uint32_t)1 << i)) == 0) {
+                this->used |= (uint32_t)1 << i;
+                return this->frames[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns a block to the pool.
+     *
+     * @param[in] frame The block returned by allocate().
+     */
+    void release(void* frame) noexcept {
+        size_t index = (static_cast<unsigned char*>(frame) - this->frames[0]) /
+                       FrameSize;
+        this->used &= ~((uint32_t)1 << index);
+    }
+
+    /**
+     * @brief Gets the number of blocks in use.
+     *
+     * @return The number of blocks in use.
+     */
+    uint8_t getUsed() {
+        return __builtin_popcountl(this->used);
+    }
+};
+
+/**
+ * @brief The pool of the frames of all DelayTask coroutines, see
+ * `DELAY_TASK_FRAME_SIZE` and `DELAY_TASK_FRAMES`.
+ */
+inline DelayFramePool<DELAY_TASK_FRAME_SIZE, DELAY_TASK_FRAMES>
+    delayTaskFrames;
+
+/**
+ * @brief This class is the return type of a cooperative coroutine that
+ * waits with `co_await Delay::for_ms()`.
+ * @class DelayTask
+ *
+ * The coroutine does not start until it is passed to
+ * DelayExecutor::spawn(). While it waits, its timer is a one-shot Delay
+ * object in the DelayScheduler, so a waiting task costs nothing per loop()
+ * pass: the scheduler resumes it from run() when the deadline expires.
+ *
+ * @code
+ * DelayScheduler scheduler;
+ * DelayExecutor executor(scheduler);
+ *
+ * DelayTask blink(uint8_t pin, unsigned long period) {
+ *   for (;;) {
+ *     digitalWrite(pin, !digitalRead(pin));
+ *     co_await Delay::for_ms(period);
+ *   }
+ * }
+ *
+ * void setup() {
+ *   executor.spawn(blink(12, 500));
+ *   executor.spawn(blink(11, 750));
+ * }
+ *
+ * void loop() {
+ *   executor.run();
+ * }
+ * @endcode
+ */
+class DelayTask {
+public:
+    /**
+     * @brief The promise of the DelayTask coroutines.
+     */
+    struct promise_type {
+        /**
+         * @brief The timer the task waits on, one-shot and registered in
+         * the scheduler of the executor.
+         */
+        Delay timer{0, false};
+
+        /**
+         * @brief The executor that runs the task, nullptr until spawned.
+         */
+        DelayExecutor* executor = nullptr;
+
+        /**
+         * @brief Takes the frame from the pool.
+         */
+        static void* operator new(size_t size) noexcept {
+            return delayTaskFrames.allocate(size);
+        }
+
+        /**
+         * @brief Returns the frame to the pool.
+         */
+        static void operator delete(void* frame) noexcept {
+            delayTaskFrames.release(frame);
+        }
+
+        /**
+         * @brief Returns an empty task when the pool has no frame.
+         */
+        static DelayTask get_return_object_on_allocation_failure() noexcept {
+            return DelayTask();
+        }
+
+        DelayTask get_return_object() noexcept {
+            return DelayTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        /**
+         * @brief The task starts in DelayExecutor::spawn().
+         */
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        /**
+         * @brief The finished task is destroyed by DelayExecutor::run(),
+         * after its timer callback has returned.
+         */
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {}
+    };
+
+    /**
+     * @brief The handle of the DelayTask coroutines.
+     */
+    typedef std::coroutine_handle<promise_type> Handle;
+
+private:
+    /**
+     * @brief The coroutine, empty if it could not be created or has been
+     * handed to an executor.
+     */
+    Handle handle;
+
+    /**
+     * @brief Constructs a new DelayTask object for the coroutine.
+     *
+     * @param[in] handle The coroutine.
+     */
+    explicit DelayTask(Handle handle) : handle(handle) {}
+
+    friend class DelayExecutor;
+
+public:
+    /**
+     * @brief Constructs a new empty DelayTask object.
+     */
+    DelayTask() = default;
+
+    /**
+     * @brief Destructor. Destroys the coroutine if it was never spawned.
+     */
+    ~DelayTask() {
+        if (this->handle) {
+            this->handle.destroy();
+        }
+    }
+
+    DelayTask(const DelayTask&) = delete;
+    DelayTask& operator=(const DelayTask&) = delete;
+
+    /**
+     * @brief Moves the coroutine from another DelayTask object.
+     *
+     * @param[in] other The task to move from, left empty.
+     */
+    DelayTask(DelayTask&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+
+    /**
+     * @brief Checks if the task holds a coroutine.
+     *
+     * @return `false` if the frame pool was full when the coroutine was
+     * called, `true` otherwise.
+     */
+    explicit operator bool() const {
+        return static_cast<bool>(this->handle);
+    }
+};
+
+/**
+ * @brief The awaitable returned by Delay::for_ms().
+ *
+ * Can only be awaited in a DelayTask coroutine run by a DelayExecutor.
+ */
+struct DelayAwaiter {
+    /**
+     * @brief The time to wait in milliseconds.
+     */
+    unsigned long ms;
+
+    /**
+     * @brief A zero wait does not suspend.
+     */
+    bool await_ready() const noexcept {
+        return this->ms == 0;
+    }
+
+    /**
+     * @brief Arms the timer of the task, the scheduler resumes the task
+     * when it expires.
+     *
+     * @param[in] handle The waiting task.
+     */
+    void await_suspend(DelayTask::Handle handle) noexcept {
+        Delay& timer = handle.promise().timer;
+        unsigned long now = millis();
+        timer.setInterval(this->ms, now);
+        timer.restart(now);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Creates an awaitable that suspends a DelayTask coroutine.
+ *
+ * @param[in] ms The time to wait in milliseconds.
+ *
+ * @return The awaitable.
+ */
+inline DelayAwaiter Delay::for_ms(unsigned long ms) {
+    return DelayAwaiter{ms};
+}
+
+/**
+ * @brief This class runs DelayTask coroutines on a DelayScheduler.
+ * @class DelayExecutor
+ *
+ * Up to `DELAY_TASK_FRAMES` tasks run at a time. The scheduler can hold
+ * other Delay objects as well, run() serves all of them.
+ */
+class DelayExecutor {
+private:
+    /**
+     * @brief The scheduler the timers of the tasks are registered in.
+     */
+    DelayScheduler& scheduler;
+
+    /**
+     * @brief The running tasks, empty handles are free slots.
+     */
+    DelayTask::Handle tasks[DELAY_TASK_FRAMES] = {};
+
+    /**
+     * @brief Resumes the task waiting on the expired timer.
+     *
+     * @param[in] address The address of the coroutine.
+     */
+    static void resume(void* address) {
+        DelayTask::Handle::from_address(address).resume();
+    }
+
+public:
+    /**
+     * @brief Constructs a new DelayExecutor object.
+     *
+     * @param[in] scheduler The scheduler that drives the tasks.
+     */
+    explicit DelayExecutor(DelayScheduler& scheduler) : scheduler(scheduler) {}
+
+    /**
+     * @brief Destructor. Destroys the tasks that are still running.
+     */
+    ~DelayExecutor() {
+        for (DelayTask::Handle& task : this->tasks) {
+            if (task) {
+                task.destroy();
+                task = nullptr;
+            }
+        }
+    }
+
+    DelayExecutor(const DelayExecutor&) = delete;
+    DelayExecutor& operator=(const DelayExecutor&) = delete;
+
+    /**
+     * @brief Starts the task. It runs until its first `co_await`.
+     *
+     * @param[in] task The task returned by a DelayTask coroutine.
+     *
+     * @return `true` if the task has been started, `false` if it is empty.
+     */
+    bool spawn(DelayTask task) {
+        if (!task) {
+            return false;
+        }
+
+        // The pool and the slots have the same size, so a task with a
+        // frame always finds a slot.
+        for (DelayTask::Handle& slot : this->tasks) {
+            if (!slot) {
+                slot = task.handle;
+                task.handle = nullptr;
+
+                DelayTask::promise_type& promise = slot.promise();
+                promise.executor = this;
+                promise.timer.setMode(DelayMode::OneShot);
+                promise.timer.setCallback(&DelayExecutor::resume,
+                                          slot.address());
+                this->scheduler.add(promise.timer);
+
+                slot.resume();
+                this->reap();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Resumes the tasks whose wait is over and runs the other due
+     * Delay objects of the scheduler.
+     *
+     * @return The number of triggered Delay objects.
+     */
+    unsigned int run() {
+        return this->run(millis());
+    }
+
+    /**
+     * @brief Resumes the tasks whose wait is over using the given current
+     * time.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of triggered Delay objects.
+     */
+    unsigned int run(unsigned long now) {
+        unsigned int fired = this->scheduler.run(now);
+        this->reap();
+        return fired;
+    }
+
+    /**
+     * @brief Destroys the finished tasks and frees their frames.
+     *
+     * A task can not be destroyed inside its own timer callback, so this
+     * is done after the scheduler pass.
+     */
+    void reap() {
+        for (DelayTask::Handle& task : this->tasks) {
+            if (task && task.done()) {
+                task.destroy();
+                task = nullptr;
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of running tasks.
+     *
+     * @return The number of running tasks.
+     */
+    uint8_t getActive() {
+        uint8_t active = 0;
+        for (DelayTask::Handle& task : this->tasks) {
+            active += task ? 1 : 0;
+        }
+
+        return active;
+    }
+};
+
+#endif  // DELAY_HAS_COROUTINES
+
+#endif  // _DELAY_TASK_H
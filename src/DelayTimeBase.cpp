@@ -0,0 +1,52 @@
+#include "DelayTimeBase.h"
+
+#if defined(ESP32)
+#include <esp_timer.h>
+#endif
+
+uint32_t DelayTimeBase::millisHigh = 0;
+uint32_t DelayTimeBase::millisLast = 0;
+uint32_t DelayTimeBase::microsHigh = 0;
+uint32_t DelayTimeBase::microsLast = 0;
+
+/**
+ * @brief Reads the time since the start in milliseconds.
+ *
+ * The low 32 bits are the value of millis().
+ *
+ * @return The current time in milliseconds.
+ */
+uint64_t DelayTimeBase::millis64() {
+#if defined(ESP32)
+    return static_cast<uint64_t>(esp_timer_get_time()) / 1000;
+#else
+    uint32_t now = millis();
+    if (now < millisLast) {
+        millisHigh++;
+    }
+
+    millisLast = now;
+    return (static_cast<uint64_t>(millisHigh) << 32) | now;
+#endif
+}
+
+/**
+ * @brief Reads the time since the start in microseconds.
+ *
+ * The low 32 bits are the value of micros().
+ *
+ * @return The current time in microseconds.
+ */
+uint64_t DelayTimeBase::micros64() {
+#if defined(ESP32)
+    return static_cast<uint64_t>(esp_timer_get_time());
+#else
+    uint32_t now = micros();
+    if (now < microsLast) {
+        microsHigh++;
+    }
+
+    microsLast = now;
+    return (static_cast<uint64_t>(microsHigh) << 32) | now;
+#endif
+}
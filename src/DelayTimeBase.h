@@ -0,0 +1,103 @@
+/**
+ * @brief Provides the shared monotonic 64-bit time base of the library.
+ *
+ */
+#ifndef _DELAY_TIME_BASE_H
+#define _DELAY_TIME_BASE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief This class extends millis() and micros() to 64-bit times that
+ * never wrap.
+ * @class DelayTimeBase
+ *
+ * There is one rollover counter per clock for the whole sketch, updated
+ * on each read: a read costs one call of the 32-bit clock, one compare
+ * and a rare increment. The DelayScheduler reads millis64() on each run()
+ * pass, the DelayProfiler reads micros64() on each loop() pass, and the
+ * 64-bit clocks of BasicDelay (`LongDelay`) read them too, so every
+ * component sees the same timeline and a sketch that polls a scheduler
+ * never misses a rollover. The components that work on 32-bit times use
+ * the low 32 bits of the same read, see millis32(), so the clock is read
+ * once per pass.
+ *
+ * On ESP32 the 64-bit `esp_timer` is read instead and no counter is kept.
+ * Elsewhere millis64() must be read at least once per 49.7 days and
+ * micros64() at least once per 71.6 minutes, and both must be read from
+ * the main code only, not from interrupts.
+ *
+ * @code
+ * void loop() {
+ *   // The uptime in days, correct well past the millis() rollover.
+ *   uint32_t days = DelayTimeBase::millis64() / 86400000;
+ * }
+ * @endcode
+ */
+class DelayTimeBase {
+private:
+    /**
+     * @brief The number of millis() rollovers seen so far.
+     */
+    static uint32_t millisHigh;
+
+    /**
+     * @brief The last value read from millis().
+     */
+    static uint32_t millisLast;
+
+    /**
+     * @brief The number of micros() rollovers seen so far.
+     */
+    static uint32_t microsHigh;
+
+    /**
+     * @brief The last value read from micros().
+     */
+    static uint32_t microsLast;
+
+public:
+    /**
+     * @brief Reads the time since the start in milliseconds.
+     *
+     * The low 32 bits are the value of millis().
+     *
+     * @return The current time in milliseconds.
+     */
+    static uint64_t millis64();
+
+    /**
+     * @brief Reads the time since the start in microseconds.
+     *
+     * The low 32 bits are the value of micros().
+     *
+     * @return The current time in microseconds.
+     */
+    static uint64_t micros64();
+
+    /**
+     * @brief Reads the time base and returns the millis() value of the
+     * read.
+     *
+     * The result is masked to 32 bits, so it matches millis() even where
+     * `unsigned long` is 64-bit, and can be passed to any method that
+     * takes the current time.
+     *
+     * @return The current time in milliseconds, modulo 2^32.
+     */
+    static unsigned long millis32() {
+        return static_cast<unsigned long>(static_cast<uint32_t>(millis64()));
+    }
+
+    /**
+     * @brief Reads the time base and returns the micros() value of the
+     * read.
+     *
+     * @return The current time in microseconds, modulo 2^32.
+     */
+    static unsigned long micros32() {
+        return static_cast<unsigned long>(static_cast<uint32_t>(micros64()));
+    }
+};
+
+#endif  // _DELAY_TIME_BASE_H
@@ -0,0 +1,431 @@
+/**
+ * @brief Provides a timing wheel for many timeouts that are re-armed often.
+ *
+ */
+#ifndef _DELAY_TIMEOUT_QUEUE_H
+#define _DELAY_TIMEOUT_QUEUE_H
+
+#include "Delay.h"
+
+/**
+ * @brief Intrusive link fields of a DelayTimeout in a slot of the wheel.
+ *
+ * Each slot is a circular list with a sentinel link, so a timeout can
+ * unlink itself without knowing its queue.
+ */
+struct DelayTimeoutLink {
+    /**
+     * @brief The previous link in the slot, nullptr if not armed.
+     */
+    DelayTimeoutLink* prev = nullptr;
+
+    /**
+     * @brief The next link in the slot, nullptr if not armed.
+     */
+    DelayTimeoutLink* next = nullptr;
+
+    /**
+     * @brief Inserts this link before the given one.
+     *
+     * @param[in] at The link to insert before.
+     */
+    void linkBefore(DelayTimeoutLink& at) {
+        this->prev = at.prev;
+        this->next = &at;
+        at.prev->next = this;
+        at.prev = this;
+    }
+
+    /**
+     * @brief Removes this link from its list. Does nothing if not linked.
+     */
+    void unlink() {
+        if (this->next != nullptr) {
+            this->prev->next = this->next;
+            this->next->prev = this->prev;
+            this->prev = nullptr;
+            this->next = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief This class is a single timeout that is armed in a
+ * DelayTimeoutQueue.
+ * @class DelayTimeout
+ *
+ * The timeout holds its own links, so the queue never allocates memory.
+ * It is expired once: after it has been popped from the queue it stays
+ * disarmed until it is armed again.
+ */
+class DelayTimeout : private DelayTimeoutLink {
+private:
+    /**
+     * @brief The time (in milliseconds) the timeout expires at.
+     */
+    unsigned long deadline = 0;
+
+    /**
+     * @brief The callback function called by DelayTimeoutQueue::run(),
+     * nullptr if not set.
+     */
+    ContextCallbackFunction callbackFunction = nullptr;
+
+    /**
+     * @brief The user context of the callback function.
+     */
+    void* callbackContext = nullptr;
+
+    /**
+     * @brief Whether the timeout has been popped by DelayTimeoutQueue::run()
+     * and its callback is still to be called.
+     */
+    bool pending = false;
+
+    template <uint16_t Slots, unsigned long Resolution>
+    friend class DelayTimeoutQueue;
+
+public:
+    /**
+     * @brief Constructs a new disarmed DelayTimeout object.
+     */
+    DelayTimeout() = default;
+
+    /**
+     * @brief Constructs a new disarmed DelayTimeout object with a callback.
+     *
+     * @param[in] fn The callback function.
+     * @param[in] context The user context, passed to `fn` as is.
+     */
+    DelayTimeout(ContextCallbackFunction fn, void* context)
+        : callbackFunction(fn), callbackContext(context) {}
+
+    /**
+     * @brief Destructor. Removes the timeout from its queue.
+     */
+    ~DelayTimeout() {
+        this->unlink();
+    }
+
+    DelayTimeout(const DelayTimeout&) = delete;
+    DelayTimeout& operator=(const DelayTimeout&) = delete;
+
+    /**
+     * @brief Disarms the timeout in O(1).
+     */
+    void cancel() {
+        this->pending = false;
+        this->unlink();
+    }
+
+    /**
+     * @brief Checks if the timeout is armed.
+     *
+     * @retval true If the timeout is in a queue and has not expired yet.
+     * @retval false otherwise.
+     */
+    bool isArmed() const {
+        return this->next != nullptr;
+    }
+
+    /**
+     * @brief Gets the time the timeout expires at.
+     *
+     * @return The deadline in milliseconds, valid while armed.
+     */
+    unsigned long getDeadline() const {
+        return this->deadline;
+    }
+
+    /**
+     * @brief Sets the callback function called by DelayTimeoutQueue::run().
+     *
+     * @param[in] fn The callback function, nullptr to remove it.
+     * @param[in] context The user context, passed to `fn` as is.
+     */
+    void setCallback(ContextCallbackFunction fn, void* context) {
+        this->callbackFunction = fn;
+        this->callbackContext = context;
+    }
+};
+
+/**
+ * @brief This class is a hashed timing wheel of DelayTimeout objects.
+ * @class DelayTimeoutQueue
+ *
+ * The deadlines are hashed into `Slots` slots of `Resolution` milliseconds
+ * each, and each slot is an intrusive list. Arming, re-arming and
+ * cancelling only unlink and link one node, so they cost O(1) whatever the
+ * number of timeouts. A re-arm with the same timeout appends the node at
+ * the tail of its new slot, which keeps the slot in deadline order.
+ *
+ * pollExpired() walks only the slots whose time has come since the last
+ * call, and compares the exact deadline of their nodes, so the wheel does
+ * not round the timeouts. A timeout longer than one turn of the wheel
+ * (`Slots * Resolution` ms) stays in its slot for more turns and is
+ * skipped on each pass. Pick the size so that most timeouts fit into one
+ * turn.
+ *
+ * @code
+ * DelayTimeoutQueue<256, 128> idleTimeouts;  // A turn of 32.8 s.
+ * DelayTimeout sessionTimeouts[MAX_SESSIONS];
+ *
+ * void onPacket(uint16_t session) {
+ *   idleTimeouts.arm(sessionTimeouts[session], 30000);
+ * }
+ *
+ * void loop() {
+ *   idleTimeouts.run();
+ * }
+ * @endcode
+ *
+ * @tparam Slots The number of slots, a power of two.
+ * @tparam Resolution The time covered by one slot in milliseconds, a power
+ * of two.
+ */
+template <uint16_t Slots = 256, unsigned long Resolution = 64>
+class DelayTimeoutQueue {
+private:
+    static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0,
+                  "DelayTimeoutQueue slots must be a power of two");
+    static_assert(Resolution > 0 && (Resolution & (Resolution - 1)) == 0,
+                  "DelayTimeoutQueue resolution must be a power of two");
+
+    /**
+     * @brief The sentinels of the slots.
+     */
+    DelayTimeoutLink slots[Slots];
+
+    /**
+     * @brief The next tick (time divided by the resolution) to walk.
+     */
+    unsigned long tick;
+
+    /**
+     * @brief Gets the slot of the given time.
+     *
+     * Both sizes are powers of two, so the mapping is continuous across
+     * the rollover of the clock.
+     *
+     * @param[in] time The time in milliseconds.
+     *
+     * @return The sentinel of the slot.
+     */
+    DelayTimeoutLink& slotOf(unsigned long time) {
+        return this->slots[(time / Resolution) & (Slots - 1)];
+    }
+
+public:
+    /**
+     * @brief Constructs a new empty DelayTimeoutQueue object.
+     */
+    DelayTimeoutQueue() : DelayTimeoutQueue(millis()) {}
+
+    /**
+     * @brief Constructs a new empty DelayTimeoutQueue object that starts
+     * at the given current time.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    explicit DelayTimeoutQueue(unsigned long now) : tick(now / Resolution) {
+        for (DelayTimeoutLink& slot : this->slots) {
+            slot.prev = &slot;
+            slot.next = &slot;
+        }
+    }
+
+    /**
+     * @brief Destructor. Disarms the timeouts still in the queue.
+     */
+    ~DelayTimeoutQueue() {
+        for (DelayTimeoutLink& slot : this->slots) {
+            while (slot.next != &slot) {
+                slot.next->unlink();
+            }
+        }
+    }
+
+    DelayTimeoutQueue(const DelayTimeoutQueue&) = delete;
+    DelayTimeoutQueue& operator=(const DelayTimeoutQueue&) = delete;
+
+    /**
+     * @brief Arms or re-arms the timeout.
+     *
+     * @param[in] timeout The timeout.
+     * @param[in] time The time until it expires in milliseconds.
+     */
+    void arm(DelayTimeout& timeout, unsigned long time) {
+        this->arm(timeout, time, millis());
+    }
+
+    /**
+     * @brief Arms or re-arms the timeout using the given current time.
+     *
+     * The time is limited to 1 ms to `0x7FFFFFFF`. A timeout never expires
+     * at the time it was armed, so a callback that re-arms its own timeout
+     * is not called again by the same run().
+     *
+     * @param[in] timeout The timeout.
+     * @param[in] time The time until it expires in milliseconds.
+     * @param[in] now The current time in milliseconds.
+     */
+    void arm(DelayTimeout& timeout, unsigned long time, unsigned long now) {
+        if (time == 0) {
+            time = 1;
+        } else if (time > 0x7FFFFFFFUL) {
+            time = 0x7FFFFFFFUL;
+        }
+
+        timeout.pending = false;
+        timeout.unlink();
+        timeout.deadline = now + time;
+        timeout.linkBefore(this->slotOf(timeout.deadline));
+    }
+
+    /**
+     * @brief Disarms the timeout, same as DelayTimeout::cancel().
+     *
+     * @param[in] timeout The timeout.
+     */
+    void cancel(DelayTimeout& timeout) {
+        timeout.cancel();
+    }
+
+    /**
+     * @brief Removes the expired timeouts from the queue.
+     *
+     * The timeouts come out in deadline order. When `out` is full, the
+     * remaining expired timeouts stay in the queue for the next call.
+     *
+     * @param[in] now The current time in milliseconds.
+     * @param[out] out The array that receives the expired timeouts,
+     * disarmed.
+     * @param[in] outSize The number of elements of `out`.
+     *
+     * @return The number of timeouts written to `out`.
+     */
+    uint16_t pollExpired(unsigned long now, DelayTimeout** out,
+                         uint16_t outSize) {
+        unsigned long last = now / Resolution;
+        unsigned long ticks = last - this->tick;
+        if (ticks >= Slots) {
+            // After a long pause, every slot is walked once.
+            ticks = Slots - 1;
+            this->tick = last - ticks;
+        }
+
+        uint16_t count = 0;
+        for (;;) {
+            DelayTimeoutLink& slot =
+                this->slots[this->tick & (Slots - 1)];
+            DelayTimeoutLink* link = slot.next;
+            while (link != &slot && count < outSize) {
+                DelayTimeout* timeout = static_cast<DelayTimeout*>(link);
+                link = link->next;
+
+                // Signed difference, so the comparison survives the
+                // rollover. Later turns stay in the slot.
+                if (delayUntil(timeout->deadline, now) <= 0) {
+                    timeout->unlink();
+                    out[count++] = timeout;
+                }
+            }
+
+            // The slot of `now` is walked again by the next call, as it
+            // can still hold timeouts that expire later in the same tick.
+            if (count >= outSize || this->tick == last) {
+                break;
+            }
+
+            this->tick++;
+        }
+
+        // The slots are walked in time order, so only the order inside a
+        // slot has to be fixed.
+        for (uint16_t i = 1; i < count; i++) {
+            DelayTimeout* timeout = out[i];
+            long key = delayUntil(timeout->deadline, now);
+            uint16_t j = i;
+            while (j > 0 && delayUntil(out[j - 1]->deadline, now) > key) {
+                out[j] = out[j - 1];
+                j--;
+            }
+
+            out[j] = timeout;
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Expires the due timeouts and calls their callbacks.
+     *
+     * @return The number of expired timeouts.
+     */
+    unsigned int run() {
+        return this->run(millis());
+    }
+
+    /**
+     * @brief Expires the due timeouts using the given current time and
+     * calls their callbacks in deadline order.
+     *
+     * The timeouts are popped in batches of eight before their callbacks
+     * run. A callback may re-arm or cancel any timeout, and a timeout of
+     * the batch that is re-armed or cancelled before its turn is not
+     * called. A callback may destroy its own timeout, but not another
+     * expired one of the batch.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of expired timeouts.
+     */
+    unsigned int run(unsigned long now) {
+        DelayTimeout* batch[8];
+        unsigned int fired = 0;
+        uint16_t count;
+        do {
+            count = this->pollExpired(now, batch, 8);
+            for (uint16_t i = 0; i < count; i++) {
+                batch[i]->pending = true;
+            }
+
+            for (uint16_t i = 0; i < count; i++) {
+                // A callback of the same batch may have re-armed or
+                // cancelled it, which clears the flag.
+                if (!batch[i]->pending) {
+                    continue;
+                }
+
+                batch[i]->pending = false;
+                fired++;
+                ContextCallbackFunction fn = batch[i]->callbackFunction;
+                if (fn != nullptr) {
+                    fn(batch[i]->callbackContext);
+                }
+            }
+        } while (count == 8);
+
+        return fired;
+    }
+
+    /**
+     * @brief Checks if no timeout is armed.
+     *
+     * Walks all slots, so it costs O(Slots).
+     *
+     * @retval true If no timeout is armed.
+     * @retval false otherwise.
+     */
+    bool isEmpty() {
+        for (DelayTimeoutLink& slot : this->slots) {
+            if (slot.next != &slot) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif  // _DELAY_TIMEOUT_QUEUE_H
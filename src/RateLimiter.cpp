@@ -0,0 +1,242 @@
+#include "RateLimiter.h"
+
+/**
+ * @brief Constructs a new full RateLimiter object.
+ *
+ * @param[in] capacity The maximum number of tokens, the burst size.
+ * @param[in] interval The time to refill one token in milliseconds, at
+ * least 1.
+ */
+RateLimiter::RateLimiter(uint16_t capacity, unsigned long interval)
+    : timestamp(millis()),
+      interval(interval == 0 ? 1 : interval),
+      capacity(capacity),
+      tokens(capacity) {}
+
+/**
+ * @brief Adds the tokens refilled since the last call.
+ *
+ * The timestamp moves by whole intervals only, so the rest of a partial
+ * interval counts towards the next token. A full bucket does not save up
+ * time.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void RateLimiter::refill(unsigned long now) {
+    if (this->tokens >= this->capacity) {
+        this->timestamp = now;
+        return;
+    }
+
+    unsigned long gained = delayElapsed(now, this->timestamp) / this->interval;
+    if (gained >= (unsigned long)(this->capacity - this->tokens)) {
+        this->tokens = this->capacity;
+        this->timestamp = now;
+    } else {
+        this->tokens += gained;
+        this->timestamp += gained * this->interval;
+    }
+}
+
+/**
+ * @brief Takes one token if available.
+ *
+ * @retval true If the token was taken.
+ * @retval false If the bucket is empty.
+ */
+bool RateLimiter::tryAcquire() {
+    return this->tryAcquire(1, millis());
+}
+
+/**
+ * @brief Takes the given number of tokens if all of them are available.
+ *
+ * @param[in] count The number of tokens.
+ *
+ * @retval true If the tokens were taken.
+ * @retval false If fewer tokens are available, none are taken.
+ */
+bool RateLimiter::tryAcquire(uint16_t count) {
+    return this->tryAcquire(count, millis());
+}
+
+/**
+ * @brief Takes the given number of tokens if all of them are available.
+ *
+ * @param[in] count The number of tokens.
+ * @param[in] now The current time in milliseconds.
+ *
+ * @retval true If the tokens were taken.
+ * @retval false If fewer tokens are available, none are taken.
+ */
+bool RateLimiter::tryAcquire(uint16_t count, unsigned long now) {
+    this->refill(now);
+    if (count > this->tokens) {
+        return false;
+    }
+
+    this->tokens -= count;
+    return true;
+}
+
+/**
+ * @brief Gets the number of available tokens.
+ *
+ * @param[in] now The current time in milliseconds.
+ *
+ * @return The number of tokens.
+ */
+uint16_t RateLimiter::getTokens(unsigned long now) {
+    this->refill(now);
+    return this->tokens;
+}
+
+/**
+ * @brief Gets the time until the given number of tokens is available.
+ *
+ * @param[in] count The number of tokens.
+ * @param[in] now The current time in milliseconds.
+ *
+ * @return The time in milliseconds, zero if they are available now, or
+ * `ULONG_MAX` if `count` is larger than the capacity.
+ */
+unsigned long RateLimiter::timeUntilAvailable(uint16_t count,
+                                              unsigned long now) {
+    if (count > this->capacity) {
+        return ULONG_MAX;
+    }
+
+    this->refill(now);
+    if (count <= this->tokens) {
+        return 0;
+    }
+
+    unsigned long missing = count - this->tokens;
+    return missing * this->interval - delayElapsed(now, this->timestamp);
+}
+
+/**
+ * @brief Fills the bucket.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void RateLimiter::reset(unsigned long now) {
+    this->tokens = this->capacity;
+    this->timestamp = now;
+}
+
+/**
+ * @brief Gets the maximum number of tokens.
+ *
+ * @return The capacity.
+ */
+uint16_t RateLimiter::getCapacity() {
+    return this->capacity;
+}
+
+/**
+ * @brief Constructs a new empty LeakyBucket object.
+ *
+ * @param[in] capacity The maximum level.
+ * @param[in] interval The time to drain one unit in milliseconds, at least
+ * 1.
+ */
+LeakyBucket::LeakyBucket(uint16_t capacity, unsigned long interval)
+    : timestamp(millis()),
+      interval(interval == 0 ? 1 : interval),
+      capacity(capacity) {}
+
+/**
+ * @brief Removes the units drained since the last call.
+ *
+ * An empty bucket does not save up time, like a full RateLimiter.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void LeakyBucket::drain(unsigned long now) {
+    if (this->level == 0) {
+        this->timestamp = now;
+        return;
+    }
+
+    unsigned long drained = delayElapsed(now, this->timestamp) / this->interval;
+    if (drained >= this->level) {
+        this->level = 0;
+        this->timestamp = now;
+    } else {
+        this->level -= drained;
+        this->timestamp += drained * this->interval;
+    }
+}
+
+/**
+ * @brief Adds one unit if it fits.
+ *
+ * @retval true If the unit was added.
+ * @retval false If the bucket is full.
+ */
+bool LeakyBucket::tryAdd() {
+    return this->tryAdd(1, millis());
+}
+
+/**
+ * @brief Adds the given number of units if all of them fit.
+ *
+ * @param[in] count The number of units.
+ *
+ * @retval true If the units were added.
+ * @retval false If they do not fit, none are added.
+ */
+bool LeakyBucket::tryAdd(uint16_t count) {
+    return this->tryAdd(count, millis());
+}
+
+/**
+ * @brief Adds the given number of units if all of them fit.
+ *
+ * @param[in] count The number of units.
+ * @param[in] now The current time in milliseconds.
+ *
+ * @retval true If the units were added.
+ * @retval false If they do not fit, none are added.
+ */
+bool LeakyBucket::tryAdd(uint16_t count, unsigned long now) {
+    this->drain(now);
+    if (count > this->capacity - this->level) {
+        return false;
+    }
+
+    this->level += count;
+    return true;
+}
+
+/**
+ * @brief Gets the current level.
+ *
+ * @param[in] now The current time in milliseconds.
+ *
+ * @return The level.
+ */
+uint16_t LeakyBucket::getLevel(unsigned long now) {
+    this->drain(now);
+    return this->level;
+}
+
+/**
+ * @brief Empties the bucket.
+ *
+ * @param[in] now The current time in milliseconds.
+ */
+void LeakyBucket::reset(unsigned long now) {
+    this->level = 0;
+    this->timestamp = now;
+}
+
+/**
+ * @brief Gets the maximum level.
+ *
+ * @return The capacity.
+ */
+uint16_t LeakyBucket::getCapacity() {
+    return this->capacity;
+}
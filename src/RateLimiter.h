@@ -0,0 +1,250 @@
+/**
+ * @brief Provides token bucket and leaky bucket rate limiters on the
+ * millis() clock.
+ *
+ */
+#ifndef _RATE_LIMITER_H
+#define _RATE_LIMITER_H
+
+#include "Delay.h"
+
+/**
+ * @brief This class is a token bucket that allows bursts up to its
+ * capacity and a sustained rate of one token per interval.
+ * @class RateLimiter
+ *
+ * The bucket is refilled lazily from the time elapsed since the last
+ * refill, computed with the same rollover-safe subtraction as Delay, so it
+ * needs no timer and no polling: each call costs a subtraction and a
+ * division. The time left over from a partial interval is kept, so the
+ * rate does not drift with the polling frequency.
+ *
+ * @code
+ * // Bursts of up to 5 uploads, then at most one every 2 s.
+ * RateLimiter uploadLimiter(5, 2000);
+ *
+ * void onSample(const Sample& sample) {
+ *   if (uploadLimiter.tryAcquire()) {
+ *     upload(sample);
+ *   }
+ * }
+ * @endcode
+ */
+class RateLimiter {
+private:
+    /**
+     * @brief The time (in milliseconds) the tokens were last counted at.
+     */
+    unsigned long timestamp;
+
+    /**
+     * @brief The time to refill one token, in milliseconds.
+     */
+    unsigned long interval;
+
+    /**
+     * @brief The maximum number of tokens.
+     */
+    uint16_t capacity;
+
+    /**
+     * @brief The number of tokens at `timestamp`.
+     */
+    uint16_t tokens;
+
+    /**
+     * @brief Adds the tokens refilled since the last call.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void refill(unsigned long now);
+
+public:
+    /**
+     * @brief Constructs a new full RateLimiter object.
+     *
+     * @param[in] capacity The maximum number of tokens, the burst size.
+     * @param[in] interval The time to refill one token in milliseconds, at
+     * least 1.
+     */
+    RateLimiter(uint16_t capacity, unsigned long interval);
+
+    /**
+     * @brief Takes one token if available.
+     *
+     * @retval true If the token was taken.
+     * @retval false If the bucket is empty.
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief Takes the given number of tokens if all of them are
+     * available.
+     *
+     * @param[in] count The number of tokens.
+     *
+     * @retval true If the tokens were taken.
+     * @retval false If fewer tokens are available, none are taken.
+     */
+    bool tryAcquire(uint16_t count);
+
+    /**
+     * @brief Takes the given number of tokens if all of them are
+     * available.
+     *
+     * @param[in] count The number of tokens.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true If the tokens were taken.
+     * @retval false If fewer tokens are available, none are taken.
+     */
+    bool tryAcquire(uint16_t count, unsigned long now);
+
+    /**
+     * @brief Gets the number of available tokens.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The number of tokens.
+     */
+    uint16_t getTokens(unsigned long now);
+
+    /**
+     * @brief Gets the time until the given number of tokens is available.
+     *
+     * @param[in] count The number of tokens.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The time in milliseconds, zero if they are available now, or
+     * `ULONG_MAX` if `count` is larger than the capacity.
+     */
+    unsigned long timeUntilAvailable(uint16_t count, unsigned long now);
+
+    /**
+     * @brief Fills the bucket.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void reset(unsigned long now);
+
+    /**
+     * @brief Gets the maximum number of tokens.
+     *
+     * @return The capacity.
+     */
+    uint16_t getCapacity();
+};
+
+/**
+ * @brief This class is a leaky bucket that accepts work while its level is
+ * below the capacity and drains one unit per interval.
+ * @class LeakyBucket
+ *
+ * Unlike the RateLimiter it starts empty, so the first burst is limited
+ * by the capacity only, and it reports how full it is. The draining is
+ * computed lazily like the refill of the RateLimiter.
+ *
+ * @code
+ * // Up to 10 queued messages, drained at one per 100 ms.
+ * LeakyBucket sendBucket(10, 100);
+ *
+ * void onMessage(const Message& message) {
+ *   if (!sendBucket.tryAdd()) {
+ *     dropped++;
+ *   }
+ * }
+ * @endcode
+ */
+class LeakyBucket {
+private:
+    /**
+     * @brief The time (in milliseconds) the level was last drained at.
+     */
+    unsigned long timestamp;
+
+    /**
+     * @brief The time to drain one unit, in milliseconds.
+     */
+    unsigned long interval;
+
+    /**
+     * @brief The maximum level.
+     */
+    uint16_t capacity;
+
+    /**
+     * @brief The level at `timestamp`.
+     */
+    uint16_t level = 0;
+
+    /**
+     * @brief Removes the units drained since the last call.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void drain(unsigned long now);
+
+public:
+    /**
+     * @brief Constructs a new empty LeakyBucket object.
+     *
+     * @param[in] capacity The maximum level.
+     * @param[in] interval The time to drain one unit in milliseconds, at
+     * least 1.
+     */
+    LeakyBucket(uint16_t capacity, unsigned long interval);
+
+    /**
+     * @brief Adds one unit if it fits.
+     *
+     * @retval true If the unit was added.
+     * @retval false If the bucket is full.
+     */
+    bool tryAdd();
+
+    /**
+     * @brief Adds the given number of units if all of them fit.
+     *
+     * @param[in] count The number of units.
+     *
+     * @retval true If the units were added.
+     * @retval false If they do not fit, none are added.
+     */
+    bool tryAdd(uint16_t count);
+
+    /**
+     * @brief Adds the given number of units if all of them fit.
+     *
+     * @param[in] count The number of units.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true If the units were added.
+     * @retval false If they do not fit, none are added.
+     */
+    bool tryAdd(uint16_t count, unsigned long now);
+
+    /**
+     * @brief Gets the current level.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The level.
+     */
+    uint16_t getLevel(unsigned long now);
+
+    /**
+     * @brief Empties the bucket.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void reset(unsigned long now);
+
+    /**
+     * @brief Gets the maximum level.
+     *
+     * @return The capacity.
+     */
+    uint16_t getCapacity();
+};
+
+#endif  // _RATE_LIMITER_H
@@ -0,0 +1,522 @@
+/**
+ * @brief Provides a compile-time specialised Delay for fixed intervals.
+ *
+ */
+#ifndef _STATIC_DELAY_H
+#define _STATIC_DELAY_H
+
+#include "Delay.h"
+
+/**
+ * @brief Tags of the optional StaticDelay features.
+ *
+ * - `Count` adds the trigger counter: getCount(), resetCount(), isEven(),
+ *   isOdd() and isNever().
+ * - `Suspend` adds the `isActive` flag: enable(), disable() and suspend().
+ * - `Callback` adds the callback function: setCallback(), hasCallback(),
+ *   getCallback() and execCallback().
+ */
+struct DelayFeature {
+    struct Count {};
+    struct Suspend {};
+    struct Callback {};
+};
+
+/**
+ * @brief Checks at compile time if the feature is in the list of features.
+ *
+ * The `value` member is `true` if `Feature` is one of `Features`.
+ */
+template <typename Feature, typename... Features>
+struct DelayHasFeature {
+    static constexpr bool value = false;
+};
+
+template <typename Feature, typename... Rest>
+struct DelayHasFeature<Feature, Feature, Rest...> {
+    static constexpr bool value = true;
+};
+
+template <typename Feature, typename First, typename... Rest>
+struct DelayHasFeature<Feature, First, Rest...>
+    : DelayHasFeature<Feature, Rest...> {};
+
+/**
+ * @brief Storage of the trigger counter of a StaticDelay.
+ *
+ * Empty when the `DelayFeature::Count` feature is not used.
+ */
+template <bool Enabled>
+class StaticDelayCount {
+protected:
+    /**
+     * @brief The number of times the object has been triggered.
+     */
+    unsigned long count = 0;
+
+    /**
+     * @brief Increments the counter when the object is triggered.
+     */
+    void countTrigger() {
+        this->count++;
+    }
+};
+
+template <>
+class StaticDelayCount<false> {
+protected:
+    void countTrigger() {}
+};
+
+/**
+ * @brief Storage of the activity and suspend state of a StaticDelay.
+ *
+ * Empty when the `DelayFeature::Suspend` feature is not used, in which case
+ * the object is always active.
+ */
+template <bool Enabled>
+class StaticDelaySuspend {
+public:
+    /**
+     * @brief Indicates whether the timer is active.
+     */
+    bool isActive = true;
+
+protected:
+    /**
+     * @brief The suspend time in milliseconds, zero if not suspended.
+     */
+    unsigned long suspendTime = 0;
+
+    /**
+     * @brief The time elapsed in the interval before the object was
+     * suspended with continuation.
+     */
+    unsigned long suspendDelta = 0;
+
+    /**
+     * @brief Checks if the object is active and ends an expired suspend.
+     *
+     * When the suspend is over, the timestamp is moved back by the time
+     * that had elapsed before the suspend, so the interval continues from
+     * where it left off.
+     *
+     * @param[in,out] timestamp The timestamp of the object.
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return `true` if the object is active, `false` otherwise, including
+     * the poll that ends the suspend.
+     */
+    bool suspendPoll(unsigned long& timestamp, unsigned long now) {
+        if (this->isActive) {
+            return true;
+        }
+
+        if (this->suspendTime != 0 &&
+            delayElapsed(now, timestamp) >= this->suspendTime) {
+            this->isActive = true;
+            this->suspendTime = 0;
+            timestamp = now - this->suspendDelta;
+            this->suspendDelta = 0;
+        }
+
+        return false;
+    }
+};
+
+template <>
+class StaticDelaySuspend<false> {
+protected:
+    bool suspendPoll(unsigned long&, unsigned long) {
+        return true;
+    }
+};
+
+/**
+ * @brief Storage of the callback function of a StaticDelay.
+ *
+ * Empty when the `DelayFeature::Callback` feature is not used.
+ */
+template <bool Enabled>
+class StaticDelayCallback {
+protected:
+    /**
+     * @brief The callback function to be invoked when the timer expires.
+     */
+    CallbackFunction callbackFunction = nullptr;
+};
+
+template <>
+class StaticDelayCallback<false> {};
+
+/**
+ * @brief This class is a Delay with an interval fixed at compile time.
+ * @class StaticDelay
+ *
+ * The interval is a template parameter, so it takes no memory and the
+ * comparison in isOver() is against a constant. The optional features are
+ * selected with the DelayFeature tags and take memory only when used. In
+ * the simplest form the object holds a single timestamp.
+ *
+ * @code
+ * StaticDelay<500> blinkDelay;  // 4 bytes on AVR
+ * StaticDelay<750, DelayFeature::Count, DelayFeature::Callback> logDelay;
+ *
+ * void loop() {
+ *   unsigned long now = millis();
+ *   if (blinkDelay.isOver(now)) {
+ *     // ...
+ *   }
+ *
+ *   logDelay.execCallback(now);
+ * }
+ * @endcode
+ *
+ * isOver() and isDone() have the same semantics as in Delay. Calling a
+ * method of a feature that is not selected fails at compile time.
+ *
+ * @tparam Interval The delay time in milliseconds.
+ * @tparam Features The DelayFeature tags of the optional features.
+ */
+template <unsigned long Interval, typename... Features>
+class StaticDelay
+    : public StaticDelayCount<
+          DelayHasFeature<DelayFeature::Count, Features...>::value>,
+      public StaticDelaySuspend<
+          DelayHasFeature<DelayFeature::Suspend, Features...>::value>,
+      public StaticDelayCallback<
+          DelayHasFeature<DelayFeature::Callback, Features...>::value> {
+private:
+    static constexpr bool hasCount =
+        DelayHasFeature<DelayFeature::Count, Features...>::value;
+    static constexpr bool hasSuspend =
+        DelayHasFeature<DelayFeature::Suspend, Features...>::value;
+    static constexpr bool hasCallbackFeature =
+        DelayHasFeature<DelayFeature::Callback, Features...>::value;
+
+    /**
+     * @brief The last time (in milliseconds) the object was triggered or
+     * initialized.
+     */
+    unsigned long timestamp;
+
+public:
+    /**
+     * @brief Constructs a new StaticDelay object started at the current
+     * time.
+     */
+    StaticDelay() : timestamp(millis()) {}
+
+    /**
+     * @brief Retrieves the delay interval.
+     *
+     * @return The delay time in milliseconds.
+     */
+    static constexpr unsigned long getInterval() {
+        return Interval;
+    }
+
+    /**
+     * @brief Resets the internal timestamp to the current time.
+     */
+    void resetTime() {
+        this->resetTime(millis());
+    }
+
+    /**
+     * @brief Resets the internal timestamp to the given current time.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void resetTime(unsigned long now) {
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Calculates the time elapsed since the last reset.
+     *
+     * @return The time difference in milliseconds.
+     */
+    unsigned long getDelta() {
+        return this->getDelta(millis());
+    }
+
+    /**
+     * @brief Calculates the time elapsed since the last reset using the
+     * given current time.
+     *
+     * The unsigned subtraction is correct across the millis() rollover.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return The time difference in milliseconds.
+     */
+    unsigned long getDelta(unsigned long now) {
+        return delayElapsed(now, this->timestamp);
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isOver() {
+        return this->isOver(millis());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time.
+     *
+     * Resets the timer and increments the counter when the interval has
+     * expired. Never returns `true` if the object is not active.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isOver(unsigned long now) {
+        if (!this->suspendPoll(this->timestamp, now)) {
+            return false;
+        }
+
+        if (delayElapsed(now, this->timestamp) >= Interval) {
+            this->countTrigger();
+            this->timestamp = now;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired and resets the timer.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone() {
+        return this->isOver(millis());
+    }
+
+    /**
+     * @brief Checks if the delay interval has expired using the given
+     * current time and resets the timer.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @retval true if the delay interval has expired.
+     * @retval false otherwise.
+     */
+    bool isDone(unsigned long now) {
+        return this->isOver(now);
+    }
+
+    /**
+     * @brief Gets the number of times the object has become active.
+     *
+     * Requires the `DelayFeature::Count` feature.
+     *
+     * @return The number of times the object has been active.
+     */
+    unsigned long getCount() {
+        static_assert(hasCount, "StaticDelay requires DelayFeature::Count");
+        return this->count;
+    }
+
+    /**
+     * @brief Resets the activation count to zero.
+     *
+     * Requires the `DelayFeature::Count` feature.
+     */
+    void resetCount() {
+        static_assert(hasCount, "StaticDelay requires DelayFeature::Count");
+        this->count = 0;
+    }
+
+    /**
+     * @brief Checks if the object has been active an even number of times.
+     *
+     * Requires the `DelayFeature::Count` feature.
+     *
+     * @retval true If the internal counter is an even number.
+     * @retval false Otherwise, including when the counter is zero.
+     */
+    bool isEven() {
+        static_assert(hasCount, "StaticDelay requires DelayFeature::Count");
+        return this->count % 2 == 0 && this->count != 0;
+    }
+
+    /**
+     * @brief Checks if the object has been active an odd number of times.
+     *
+     * Requires the `DelayFeature::Count` feature.
+     *
+     * @retval true If the internal counter is an odd number.
+     * @retval false Otherwise, including when the counter is zero.
+     */
+    bool isOdd() {
+        static_assert(hasCount, "StaticDelay requires DelayFeature::Count");
+        return this->count % 2 != 0 && this->count != 0;
+    }
+
+    /**
+     * @brief Checks if the object has never been active.
+     *
+     * Requires the `DelayFeature::Count` feature.
+     *
+     * @retval true If the internal counter is zero.
+     * @retval false otherwise.
+     */
+    bool isNever() {
+        static_assert(hasCount, "StaticDelay requires DelayFeature::Count");
+        return this->count == 0;
+    }
+
+    /**
+     * @brief Enables the object and cancels any active suspend state.
+     *
+     * Requires the `DelayFeature::Suspend` feature.
+     */
+    void enable() {
+        this->enable(millis());
+    }
+
+    /**
+     * @brief Enables the object using the given current time.
+     *
+     * Requires the `DelayFeature::Suspend` feature.
+     *
+     * @param[in] now The current time in milliseconds.
+     */
+    void enable(unsigned long now) {
+        static_assert(hasSuspend,
+                      "StaticDelay requires DelayFeature::Suspend");
+        this->isActive = true;
+        this->suspendTime = 0;
+        this->suspendDelta = 0;
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Disables the object and cancels any active suspend state.
+     *
+     * Requires the `DelayFeature::Suspend` feature.
+     */
+    void disable() {
+        static_assert(hasSuspend,
+                      "StaticDelay requires DelayFeature::Suspend");
+        this->isActive = false;
+        this->suspendTime = 0;
+        this->suspendDelta = 0;
+    }
+
+    /**
+     * @brief Suspends the object for a specified amount of time.
+     *
+     * Requires the `DelayFeature::Suspend` feature.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * milliseconds.
+     * @param[in] shouldContinue (Optional) If set to `true`, the timer will
+     * continue counting from where it left off before being suspended.
+     */
+    void suspend(unsigned long suspendTime, bool shouldContinue = false) {
+        this->suspend(suspendTime, shouldContinue, millis());
+    }
+
+    /**
+     * @brief Suspends the object using the given current time.
+     *
+     * Requires the `DelayFeature::Suspend` feature.
+     *
+     * @param[in] suspendTime The amount of time to suspend the object, in
+     * milliseconds.
+     * @param[in] shouldContinue If set to `true`, the timer will continue
+     * counting from where it left off before being suspended.
+     * @param[in] now The current time in milliseconds.
+     */
+    void suspend(unsigned long suspendTime, bool shouldContinue,
+                 unsigned long now) {
+        static_assert(hasSuspend,
+                      "StaticDelay requires DelayFeature::Suspend");
+        this->suspendDelta =
+            shouldContinue ? delayElapsed(now, this->timestamp) : 0;
+        this->suspendTime = suspendTime;
+        this->isActive = false;
+        this->timestamp = now;
+    }
+
+    /**
+     * @brief Sets the callback function for the timer.
+     *
+     * Requires the `DelayFeature::Callback` feature.
+     *
+     * @param[in] fn The callback function.
+     */
+    void setCallback(CallbackFunction fn) {
+        static_assert(hasCallbackFeature,
+                      "StaticDelay requires DelayFeature::Callback");
+        this->callbackFunction = fn;
+    }
+
+    /**
+     * @brief Checks if a callback function is set.
+     *
+     * Requires the `DelayFeature::Callback` feature.
+     *
+     * @return True if a callback function is set, false otherwise.
+     */
+    bool hasCallback() {
+        static_assert(hasCallbackFeature,
+                      "StaticDelay requires DelayFeature::Callback");
+        return this->callbackFunction != nullptr;
+    }
+
+    /**
+     * @brief Retrieves the current callback function.
+     *
+     * Requires the `DelayFeature::Callback` feature.
+     *
+     * @return The current callback function or nullptr.
+     */
+    CallbackFunction getCallback() {
+        static_assert(hasCallbackFeature,
+                      "StaticDelay requires DelayFeature::Callback");
+        return this->callbackFunction;
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired.
+     *
+     * Requires the `DelayFeature::Callback` feature.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback() {
+        return this->execCallback(millis());
+    }
+
+    /**
+     * @brief Executes the callback function if the interval has expired
+     * using the given current time.
+     *
+     * Requires the `DelayFeature::Callback` feature.
+     *
+     * @param[in] now The current time in milliseconds.
+     *
+     * @return True if the callback function was executed, false otherwise.
+     */
+    bool execCallback(unsigned long now) {
+        if (this->hasCallback() && this->isOver(now)) {
+            this->callbackFunction();
+            return true;
+        }
+
+        return false;
+    }
+};
+
+#endif  // _STATIC_DELAY_H